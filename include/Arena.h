@@ -0,0 +1,85 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <cstddef>
+#include <new>
+#include <atomic>
+#include <vector>
+#include <imgui.h>
+
+namespace BluePrint
+{
+// Monotonic memory for the nodes and pins of one BP, so they sit next to each other in creation order.
+// Node and Pin allocate through Arena::New, which takes the arena of the innermost ArenaScope on the
+// calling thread or the heap without one. Deleting an arena object runs its destructor only, the memory
+// comes back with Release. Not thread-safe, the BP owning it serializes creation.
+// Every block points back at its arena, so an arena never moves. An owner giving up an arena on the heap
+// while objects are still alive calls Drop, the last Delete frees it then.
+struct IMGUI_API Arena
+{
+    static constexpr size_t CHUNK_SIZE = 256 * 1024;
+
+    Arena() = default;
+    Arena(const Arena&) = delete;
+    ~Arena();
+
+    Arena& operator=(const Arena&) = delete;
+
+    void* Allocate(size_t size, size_t align);
+    bool Release();     // frees all chunks at once, false (and nothing freed) while objects from New are alive
+    void Drop();        // for an arena from new, deletes it now or with the last object from New
+
+    // unique_ptr deleter calling Drop
+    struct Dropper
+    {
+        void operator()(Arena* arena) const { arena->Drop(); }
+    };
+
+    size_t Used() const { return m_Used; }
+    size_t Capacity() const { return m_Capacity; }
+    size_t Live() const { return m_Refs.load(std::memory_order_relaxed) - 1; }
+
+    static void* New(size_t size, size_t align = alignof(std::max_align_t));
+    static void Delete(void* ptr);
+    static Arena* Current();
+
+private:
+    friend struct ArenaScope;
+
+    void FreeChunks();
+
+    struct Chunk
+    {
+        char*   m_Data;
+        size_t  m_Size;
+    };
+
+    std::vector<Chunk>  m_Chunks;
+    char*               m_Head {nullptr};
+    char*               m_End {nullptr};
+    size_t              m_Used {0};
+    size_t              m_Capacity {0};
+    std::atomic<size_t> m_Refs {1};     // objects from New, plus one for the owner until Drop
+};
+
+// Routes Node/Pin allocations on this thread to arena while alive, nullptr routes them to the heap
+struct IMGUI_API ArenaScope
+{
+    ArenaScope(Arena* arena);
+    ~ArenaScope();
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+    Arena* m_Previous;
+};
+} // namespace BluePrint
+
+# define BP_ARENA_ALLOCATED \
+    static void* operator new(size_t size) { return ::BluePrint::Arena::New(size); } \
+    static void* operator new(size_t size, std::align_val_t align) { return ::BluePrint::Arena::New(size, static_cast<size_t>(align)); } \
+    static void operator delete(void* ptr) { ::BluePrint::Arena::Delete(ptr); } \
+    static void operator delete(void* ptr, std::align_val_t) { ::BluePrint::Arena::Delete(ptr); } \
+    static void* operator new(size_t, void* where) { return where; } \
+    static void operator delete(void*, void*) {}
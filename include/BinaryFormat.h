@@ -0,0 +1,147 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <imgui.h>
+#include <imgui_json.h>
+
+namespace BluePrint
+{
+// Compact binary form of a Document/BP json, saved beside the json one and detected by its magic.
+// Every json value is a fixed size record, members of an object or array sit next to each other,
+// strings and keys are stored once in a string table. Node records point at each node object and
+// pin/link arrays list every pin and its link, so a mapped file can be inspected without decoding.
+// BP::Load and Document::Load create nodes from the node records and decode one node object at a time,
+// Decode gives back the exact json it was made from for everything else.
+// Every value but the root has exactly one parent, values nest at most BP_BINARY_MAX_DEPTH deep.
+// Files are written in host order and assumed little endian, sections are 8 byte aligned.
+#define BP_BINARY_MAGIC     0x4E425042  // "BPBN"
+#define BP_BINARY_VERSION   1
+#define BP_BINARY_NONE      0xFFFFFFFF
+#define BP_BINARY_MAX_DEPTH 256
+
+enum class BinaryValueType : uint8_t
+{
+    Null,
+    Object,
+    Array,
+    String,
+    Boolean,
+    Number
+};
+
+struct BinaryHeader
+{
+    uint32_t    m_Magic;
+    uint16_t    m_Version;
+    uint16_t    m_HeaderSize;
+    uint64_t    m_FileSize;
+    uint32_t    m_Root;             // value index of the top json value
+    uint32_t    m_StringCount;
+    uint32_t    m_ValueCount;
+    uint32_t    m_NodeCount;
+    uint32_t    m_PinCount;
+    uint32_t    m_LinkCount;
+    uint64_t    m_StringOffset;     // BinaryString[m_StringCount]
+    uint64_t    m_StringDataOffset; // utf8 bytes, every string zero terminated
+    uint64_t    m_StringDataSize;
+    uint64_t    m_ValueOffset;      // BinaryValue[m_ValueCount]
+    uint64_t    m_NodeOffset;       // BinaryNode[m_NodeCount]
+    uint64_t    m_PinOffset;        // BinaryPin[m_PinCount]
+    uint64_t    m_LinkOffset;       // BinaryLink[m_LinkCount]
+};
+
+struct BinaryString
+{
+    uint32_t    m_Offset;           // in string data
+    uint32_t    m_Length;           // without terminator
+};
+
+struct BinaryValue
+{
+    BinaryValueType m_Type;
+    uint8_t         m_Reserved[3];
+    uint32_t        m_Key;          // string index of the member name in an object, BP_BINARY_NONE otherwise
+    union
+    {
+        double      m_Number;
+        uint64_t    m_Boolean;
+        uint32_t    m_String;       // string index
+        struct
+        {
+            uint32_t m_First;       // value index of the first member
+            uint32_t m_Count;
+        }           m_Children;
+    };
+};
+
+struct BinaryNode
+{
+    uint32_t    m_Value;            // value index of the node object
+    uint32_t    m_ID;
+    uint32_t    m_TypeID;
+    uint32_t    m_Name;             // string index, BP_BINARY_NONE without name
+};
+
+struct BinaryPin
+{
+    uint32_t    m_ID;
+    uint32_t    m_Node;             // index in node records
+    uint32_t    m_Value;            // value index of the pin object
+    uint32_t    m_Output;           // 1 for output pins
+};
+
+struct BinaryLink
+{
+    uint32_t    m_Receiver;         // pin id with the link
+    uint32_t    m_Provider;         // pin id it links to
+};
+
+static_assert(sizeof(BinaryValue) == 16, "BinaryValue must stay 16 bytes");
+
+// A binary file mapped read-only, the records stay valid until Close
+struct IMGUI_API BinaryDocument
+{
+    BinaryDocument() = default;
+    BinaryDocument(const BinaryDocument&) = delete;
+    BinaryDocument& operator=(const BinaryDocument&) = delete;
+    ~BinaryDocument();
+
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const { return m_Header != nullptr; }
+
+    const BinaryHeader& Header() const { return *m_Header; }
+    uint32_t NodeCount() const { return m_Header ? m_Header->m_NodeCount : 0; }
+    uint32_t PinCount() const { return m_Header ? m_Header->m_PinCount : 0; }
+    uint32_t LinkCount() const { return m_Header ? m_Header->m_LinkCount : 0; }
+    const BinaryNode& Node(uint32_t index) const { return m_Nodes[index]; }
+    const BinaryPin& Pin(uint32_t index) const { return m_Pins[index]; }
+    const BinaryLink& Link(uint32_t index) const { return m_Links[index]; }
+    const BinaryValue& Value(uint32_t index) const { return m_Values[index]; }
+    std::string String(uint32_t index) const;
+    uint32_t Root() const { return m_Header ? m_Header->m_Root : BP_BINARY_NONE; }
+    uint32_t Member(uint32_t object, const char* key) const;   // value index of a member, BP_BINARY_NONE when missing
+
+    imgui_json::value Decode() const;                   // whole file
+    imgui_json::value Decode(uint32_t value) const;     // one value, e.g. Node(i).m_Value
+
+    static bool IsBinaryFile(const std::string& path);
+    static bool Save(const imgui_json::value& value, const std::string& path);
+    static std::pair<imgui_json::value, bool> Load(const std::string& path);
+
+private:
+    bool Validate(size_t size);
+
+    const uint8_t*      m_Data {nullptr};
+    size_t              m_Size {0};
+    bool                m_Mapped {false};
+    const BinaryHeader* m_Header {nullptr};
+    const BinaryString* m_Strings {nullptr};
+    const char*         m_StringData {nullptr};
+    const BinaryValue*  m_Values {nullptr};
+    const BinaryNode*   m_Nodes {nullptr};
+    const BinaryPin*    m_Pins {nullptr};
+    const BinaryLink*   m_Links {nullptr};
+};
+} // namespace BluePrint
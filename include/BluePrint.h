@@ -7,8 +7,14 @@
 #include <thread>
 #include <atomic>
 #include <mutex>
+#include <condition_variable>
+#include <future>
+#include <chrono>
+#include <functional>
 #include <algorithm>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include <memory>
 #include <imgui_json.h>
 //#include <variant.hpp>  // variant for C++14
@@ -18,6 +24,7 @@
 #include <imgui.h>
 #include <imgui_helper.h>
 #include <version.h>
+#include <Arena.h>
 
 #define BP_ERR_NONE          0
 #define BP_ERR_GENERAL      -1
@@ -89,7 +96,10 @@ inline uint32_t fnv1a_hash_32(string str)
 
 struct NodeRegistry;
 struct Node;
+struct NodeState;
 struct Context;
+struct Executor;
+struct BinaryDocument;
 enum class StepResult
 {
     Success,
@@ -110,8 +120,114 @@ private:
 };
 # pragma endregion
 
+# pragma region ExecutionPlan
+// One instruction per flow pin, links and group bridge/shadow pins are resolved at compile time
+struct FlowInstruction
+{
+    FlowPin*    m_Pin       {nullptr};  // flow pin this instruction stands for
+    int32_t     m_Next      {-1};       // instruction of the input flow pin reached through m_Pin, -1 if unresolved
+    bool        m_HasLink   {false};    // m_Pin is linked to a flow pin of another node
+};
+
+struct IMGUI_API ExecutionPlan
+{
+    ExecutionPlan() = default;
+    ExecutionPlan(const ExecutionPlan&) = delete;
+    ExecutionPlan& operator=(const ExecutionPlan&) = delete;
+
+    void Clear();
+    void Invalidate() { m_Valid = false; }
+    bool IsValid() const { return m_Valid; }
+
+    const FlowInstruction* Find(ID_TYPE pinId) const;
+    const FlowInstruction* Resolve(ID_TYPE pinId) const;
+    const std::vector<const Pin*>* FindParallelInputs(const Node& node) const;
+
+    std::vector<FlowInstruction>            m_Instructions;
+    std::unordered_map<ID_TYPE, int32_t>    m_Index;
+    // provider pins of independent heavy thread-safe subtrees feeding a node, evaluated together before it executes
+    std::unordered_map<const Node*, std::vector<const Pin*>> m_ParallelInputs;
+    uint32_t                                m_SlotCount {0};
+    uint32_t                                m_Generation {0};   // bumped by every compile, never reset
+    std::atomic<bool>                       m_Valid {false};
+};
+# pragma endregion
+
+# pragma region ContextSync
+// Execution state as seen from other threads (UI/debugger)
+struct ContextSnapshot
+{
+    Node*       m_CurrentNode {nullptr};
+    Node*       m_PrevNode {nullptr};
+    FlowPin*    m_CurrentFlowPin {nullptr};     // registered pin, not the copy held by Context
+};
+
+// Per context seqlock, execution thread publishes a snapshot after each state change, readers never block it.
+// Also carries debugger commands to the execution thread, which sleeps on it while paused.
+struct IMGUI_API ContextSync
+{
+    enum Command : uint32_t
+    {
+        CMD_NONE            = 0,
+        CMD_STEP_NEXT       = 1 << 0,
+        CMD_STEP_CURRENT    = 1 << 1,
+        CMD_STEP_TO_END     = 1 << 2,
+        CMD_RESUME          = 1 << 3,
+    };
+
+    ContextSync() = default;
+    ContextSync(const ContextSync& other) { Publish(other.Snapshot()); }
+    ~ContextSync() { m_Parked->store(0, std::memory_order_release); }
+    ContextSync& operator=(const ContextSync& other) { Publish(other.Snapshot()); return *this; }
+
+    void Publish(const ContextSnapshot& snapshot);
+    ContextSnapshot Snapshot() const;
+
+    void Post(uint32_t commands);                       // queue commands and wake the execution thread
+    uint32_t Take();                                    // fetch and clear queued commands
+    void Wake();                                        // wake the execution thread to re-check its state
+    void Wait(const std::function<bool()>& ready);      // sleep until commands are queued or ready() holds
+    void WaitUntil(std::chrono::steady_clock::time_point time, const std::function<bool()>& ready);    // same, up to time
+
+    // A suspended threaded run leaves its worker, whoever unparks it first submits the rest of the run.
+    // Timed resumes hold the cell rather than the context, so one firing after the context is gone is harmless.
+    using ParkCell = std::shared_ptr<std::atomic<uint32_t>>;
+    uint32_t Park();                                    // token of the parked run, 0 when a resume was already queued
+    bool Unpark(uint32_t token) { return Unpark(m_Parked, token); }
+    static bool Unpark(const ParkCell& cell, uint32_t token);
+    uint32_t Parked() const { return m_Parked->load(std::memory_order_acquire); }
+    const ParkCell& Parking() const { return m_Parked; }
+
+    std::mutex& MonitorMutex() const { return m_MonitorMutex; }
+
+private:
+    std::atomic<uint32_t>   m_Commands {CMD_NONE};
+    std::mutex              m_WaitMutex;
+    std::condition_variable m_WaitCondition;
+
+    ParkCell                m_Parked = std::make_shared<std::atomic<uint32_t>>(0);
+    std::atomic<uint32_t>   m_ParkCount {0};
+
+    std::atomic<uint32_t>   m_Sequence {0};
+    std::atomic<Node*>      m_CurrentNode {nullptr};
+    std::atomic<Node*>      m_PrevNode {nullptr};
+    std::atomic<FlowPin*>   m_CurrentFlowPin {nullptr};
+    mutable std::mutex      m_MonitorMutex;     // held while monitor callbacks run
+};
+# pragma endregion
 
 # pragma region Context
+// Run state written by the UI thread and read by the execution thread, copies take the current value
+template <typename T>
+struct ContextAtomic : std::atomic<T>
+{
+    ContextAtomic(T value = T()) : std::atomic<T>(value) {}
+    ContextAtomic(const ContextAtomic& other) : std::atomic<T>(other.load()) {}
+    ContextAtomic& operator=(const ContextAtomic& other) { this->store(other.load()); return *this; }
+    using std::atomic<T>::operator=;
+};
+using ContextFlag = ContextAtomic<bool>;
+
 struct ContextMonitor
 {
     virtual ~ContextMonitor() {};
@@ -132,11 +248,19 @@ struct IMGUI_API Context
     void SetContextMonitor(ContextMonitor* monitor);
             ContextMonitor* GetContextMonitor();
     const   ContextMonitor* GetContextMonitor() const;
+    void CopySettings(const Context& other);    // monitor and executor only, run state and values stay with other
 
     void ResetState();
+    bool ResetState(std::unordered_set<const Node*> dirtyNodes);   // incremental, keeps last run values, false when there is nothing to keep
+    bool CanReplay(const Node& node) const;
+    void DropPinValue(const Pin& pin);
+    void Prefetch(const std::vector<const Pin*>& pins);    // evaluate provider pins on the executor and keep the results in the step cache
+    std::unique_ptr<Context> Fork();                        // branch context with the current values and empty node states, Reset the nodes it runs first
+    void Merge(const Context& child);                       // take over the values a branch context has set
 
     StepResult Start(FlowPin& entryPoint, bool bypass_bg_node = false);
     StepResult Step(Context * context = nullptr, bool restep = false);
+    FlowPin ExecuteNode(Node& node, FlowPin& entryPin, bool threading = false);    // one node with replay, prefetch and timing stats, used by Step and RunInline
     StepResult Restep(Context * context = nullptr);
     StepResult StepToEnd(Node* node = nullptr);
     
@@ -161,27 +285,58 @@ struct IMGUI_API Context
     uint32_t StepCount() const;
 
     void PushReturnPoint(FlowPin& entryPoint);
+    void PopReturnPoint();
+
+    // Tight loop support, runs the flow behind a loop body pin on this thread without going back to Step.
+    // Success when the body ran to its end, Done when a breakpoint or exit node handed the flow back to Step.
+    bool CanRunInline() const;
+    StepResult RunInline(FlowPin& bodyPin, bool threading = false);
+    // Runs bodyPin inline as long as next sets up another iteration and returns true, the return point to
+    // entryPoint stays pushed meanwhile. False when Step takes over (error, suspend, pause), return no pin then
+    template <typename F>
+    bool RunInlineLoop(FlowPin& entryPoint, FlowPin& bodyPin, F&& next, bool threading = false);
+
+    // Waiting nodes push their return point, call Suspend and return no pin instead of sleeping.
+    // A threaded run hands its worker back until the timeout passes or Resume is called, blocking runs sleep.
+    void Suspend(int32_t timeoutMs = -1);   // negative waits for Resume only
+    void Suspend(std::chrono::steady_clock::time_point wakeTime);   // absolute deadline, periodic nodes do not drift
+    void Resume();                          // callable from any thread, e.g. on I/O completion
+    bool IsSuspended() const { return m_Suspended; }
 
     template <typename T>
     auto GetPinValue(Pin& pin, bool threading = false) const;
+    template <typename T>
+    PinValueRef<T> GetPinValueRef(const Pin& pin, bool threading = false) const;  // no copy of strings, mats and arrays
 
     void SetPinValue(const Pin& pin, PinValue value);
     PinValue GetPinValue(const Pin& pin, bool threading = false) const;
+    const PinValue* FindStoredValue(const Pin& pin) const;    // set by SetPinValue here or in a parent, nullptr otherwise
+    const PinValue* PeekPinValue(const Pin& pin) const;       // borrowed, follows links to a stored or cached value, nullptr when it needs evaluating
+
+    NodeState& GetNodeState(const Node& node);
+    template <typename T>
+    T& GetNodeState(const Node& node) { return static_cast<T&>(GetNodeState(node)); }
 
     StepResult SetStepResult(StepResult result);
 
     void ShowFlow();
 
-    ContextMonitor*             m_Monitor  {nullptr};
-    bool                        m_Executing {false};
-    bool                        m_Paused {false};
+    void Publish();
+    void InvalidateCache();
+    std::mutex& MonitorMutex() const { return m_Sync.MonitorMutex(); }
+
+    ContextAtomic<ContextMonitor*> m_Monitor {nullptr};  // the UI lends it under MonitorMutex while the run steps
+    ContextFlag                 m_Executing {false};
+    ContextFlag                 m_Paused {false};
     bool                        m_StepToNext {false};
     bool                        m_StepCurrent {false};
-    bool                        m_StepToEnd {false};
-    bool                        m_ThreadRunning {false};    // sub-thread is running
+    ContextFlag                 m_StepToEnd {false};
+    ContextFlag                 m_ThreadRunning {false};    // sub-thread is running
     bool                        m_pause_event   {false};
     bool                        m_bypass_bg_node {false};
-
+    bool                        m_Shared {false};           // created by BP::CreateContext, node objects are left untouched
+    bool                        m_Incremental {false};      // clean nodes replay their last result, see BP::Rerun
+    bool                        m_Suspended {false};        // last step asked to wait, see Suspend
 
     std::vector<FlowPin>            m_Callstack;
     Node*                           m_CurrentNode {nullptr};
@@ -192,14 +347,62 @@ struct IMGUI_API Context
     FlowPin                         m_PrevFlowPin = {};
     StepResult                      m_LastResult {StepResult::Done};
     uint32_t                        m_StepCount {0};
-    std::map<uint32_t, PinValue>    m_Values;
-    std::thread*                    m_thread {nullptr};
+    std::vector<PinValue>           m_SlotValues;   // indexed by Pin::m_Slot
+    std::vector<uint32_t>           m_SlotEpochs;   // slot is set in this run when equal to m_Epoch
+    uint32_t                        m_Epoch {1};
+    std::map<uint32_t, PinValue>    m_Values;       // pins without slot
+    mutable std::vector<PinValue>   m_CacheValues;  // EvaluatePin results, indexed by Pin::m_Slot
+    mutable std::vector<uint32_t>   m_CacheEpochs;  // cached value is valid when equal to m_CacheEpoch
+    uint32_t                        m_CacheEpoch {1};   // advanced every step and on every SetPinValue
+    std::thread::id                 m_ExecThread;       // only this thread fills the cache
+    std::shared_future<void>        m_Task;                 // threaded run submitted to m_Executor, ready when the run ended
+    std::shared_ptr<std::promise<void>> m_TaskDone;         // completes m_Task, a suspended run spans several executor tasks
+    ContextMonitor*                 m_TaskMonitor {nullptr};    // monitor detached while the threaded run steps
+    std::chrono::steady_clock::time_point m_WakeTime {};    // end of a Suspend timeout, default when only Resume wakes
+    Executor*                       m_Executor {nullptr};   // nullptr uses Executor::GetDefault()
+    const ExecutionPlan*            m_Plan {nullptr};
+    ContextSync                     m_Sync;
+    std::unordered_map<const Node*, std::shared_ptr<NodeState>> m_NodeStates;
+    uint32_t                        m_StateGeneration {0};  // plan generation m_NodeStates belongs to
+    std::unordered_set<const Node*> m_DirtyNodes;           // nodes re-executed by an incremental run
+    Context*                        m_Parent {nullptr};     // set on branch contexts made by Fork
+    Node*                           m_JoinNode {nullptr};   // JoinNode which ended this branch
+    std::unordered_set<const Pin*>  m_Written;              // pins set by this branch, replayed by Merge
 };
 
 template <typename T>
 inline auto Context::GetPinValue(Pin& pin, bool threading) const
 {
-    return GetPinValue(pin, threading).As<T>();
+    return T(GetPinValueRef<T>(pin, threading).Get());
+}
+
+template <typename T>
+inline PinValueRef<T> Context::GetPinValueRef(const Pin& pin, bool threading) const
+{
+    if (auto value = PeekPinValue(pin))
+        return PinValueRef<T>(*value);
+    return PinValueRef<T>(GetPinValue(pin, threading));
+}
+
+template <typename F>
+inline bool Context::RunInlineLoop(FlowPin& entryPoint, FlowPin& bodyPin, F&& next, bool threading)
+{
+    PushReturnPoint(entryPoint);
+    for (;;)
+    {
+        // the return point stays, Step enters the node again
+        if (!CanRunInline())
+            return false;
+        if (!next())
+            break;
+        auto result = RunInline(bodyPin, threading);
+        if (result == StepResult::Error)
+            PopReturnPoint();
+        if (result != StepResult::Success)
+            return false;
+    }
+    PopReturnPoint();
+    return true;
 }
 
 # pragma endregion
@@ -314,6 +517,19 @@ struct IMGUI_API BP
 
     void Clear();
 
+    // Nodes and pins created from now on go to an arena released in one go by Clear, see Arena
+    void EnableArena(bool enable) { m_UseArena = enable; }
+    bool IsArenaEnabled() const { return m_UseArena; }
+    Arena* GetArena();
+
+    void Compile();
+    void InvalidatePlan();
+    const ExecutionPlan& GetExecutionPlan() const;
+    // Flow reached from branches and data feeding inputs only touches thread-safe nodes, and no branch executes another one's nodes
+    bool CanRunConcurrently(const Node& owner, span<FlowPin* const> branches, span<Pin* const> inputs = {}) const;
+    // Nodes the flow from branch executes before a JoinNode, owner included when the flow returns to it. Needs a compiled plan
+    std::vector<Node*> CollectBranchNodes(const Node& owner, const FlowPin& branch) const;
+
     span<      Node*>       GetNodes();
     span<const Node* const> GetNodes() const;
 
@@ -337,11 +553,19 @@ struct IMGUI_API BP
 
     StepResult Run(Node& entryPointNode, bool bypass_bg_node = false);
     StepResult Execute(Node& entryPointNode, bool bypass_bg_node = false);
+
+    // Extra contexts run the same graph concurrently, graph must not be edited while any of them executes
+    std::unique_ptr<Context> CreateContext();
+    StepResult Run(Context& context, Node& entryPointNode, bool bypass_bg_node = false);
+    StepResult Execute(Context& context, Node& entryPointNode, bool bypass_bg_node = false);
     StepResult Stop();
     StepResult Pause();
     StepResult Next();
     StepResult Current();
     StepResult StepToEnd(Node * node = nullptr);
+    // Incremental run, only nodes marked dirty and their data consumers execute again, other nodes keep the last run result
+    void MarkDirty(Node* node);
+    StepResult Rerun(Node& entryPointNode, bool bypass_bg_node = false);
     bool IsOpened() { return m_IsOpen; }
     void SetOpen(bool opened) { m_IsOpen = opened; }
     bool IsExecuting();
@@ -363,6 +587,7 @@ struct IMGUI_API BP
     uint32_t StepCount() const;
 
     int Load(const imgui_json::value& value);
+    int Load(const BinaryDocument& document, uint32_t value);   // BP object at value, nodes come from the node records
     int Import(const imgui_json::value& value, ImVec2 pos);
     void Save(imgui_json::value& value) const;
 
@@ -382,7 +607,15 @@ struct IMGUI_API BP
     int64_t GetTimeStamp() { return m_TimeStamp; }
     int64_t GetDurtion() { return m_Duration; }
 
-    std::vector<Pin*> FindPinsLinkedTo(const Pin& pin) const;
+    std::vector<Pin*> FindPinsLinkedTo(const Pin& pin) const;  // receivers whose link is pin
+    // Keep the link index in step, called by Pin::LinkTo/Unlink. Pin::Load marks it stale
+    void OnPinLinked(Pin& receiver, ID_TYPE provider);
+    void OnPinUnlinked(Pin& receiver, ID_TYPE provider);
+    void InvalidateLinkIndex() { m_LinkIndexDirty = true; }
+    // Ids were rewritten outside BP (Load, group import), lookups scan until the next RebuildIndex
+    void InvalidateIndex() { m_IndexDirty = true; m_LinkIndexDirty = true; }
+    // A flow path leads from one node to the other, answered from a topological order kept up to date on link
+    bool FlowReaches(const Node& from, const Node& to) const;
 
     void OnContextRunDone();
     void OnContextPause();
@@ -394,16 +627,48 @@ struct IMGUI_API BP
 
 private:
     void ResetState();
+    void ResetState(Context& context);
+    void ResetState(Context& context, bool incremental);
+    std::unordered_set<const Node*> CollectDirtyNodes() const;
+    bool CollectParallelSubtree(Node* node, bool& heavy, std::unordered_set<const Node*>& visited) const;
+    void RebuildIndex();
+    void UpdateLinkIndex() const;
+    void UpdateFlowOrder() const;
+    int64_t FlowOrderOf(const Node* node) const;
+    void FlowSuccessors(const Node* node, std::vector<const Node*>& result) const;
+    void FlowPredecessors(const Node* node, std::vector<const Node*>& result) const;
+    void InsertFlowEdge(const Node* from, const Node* to);
+    size_t NodePosition(ID_TYPE nodeId) const;
     Node * CreateDummyNode(const imgui_json::value& value, BP* blueprint);
+    Node * LoadNode(ID_TYPE typeId, const imgui_json::value& value);
 
     static shared_ptr<NodeRegistry>        s_NodeRegistry;
     static shared_ptr<PinExRegistry>       s_PinExRegistry;
     IDGenerator                     m_Generator;
+    std::unique_ptr<Arena, Arena::Dropper> m_Arena; // declared before the nodes, outlives them. Boxed since blocks point back at it
     std::vector<Node*>              m_Nodes;
     std::vector<Pin*>               m_Pins;
+    // lookup index, id entries are checked against m_Nodes/m_Pins since ids may be rewritten by Load.
+    // A miss is final unless m_IndexDirty, then a scan finds the id and repairs its entry
+    mutable std::unordered_map<ID_TYPE, size_t> m_NodeIndex;
+    mutable std::unordered_map<ID_TYPE, size_t> m_PinIndex;
+    std::unordered_map<const Pin*, size_t>      m_PinPositions;
+    bool                                        m_IndexDirty {false};
+    // reverse links, provider id to receivers. Entries are checked against m_PinPositions and
+    // m_Link on read, links set without LinkTo are picked up by a rebuild when it is dirty
+    mutable std::unordered_map<ID_TYPE, std::vector<Pin*>>  m_LinkIndex;
+    mutable bool                                            m_LinkIndexDirty {true};
+    // topological order of nodes along flow links (Pearce-Kelly), rebuilt with the link index,
+    // without a valid order (the graph has a flow loop) FlowReaches falls back to a plain search
+    mutable std::unordered_map<const Node*, int64_t>        m_FlowOrder;
+    mutable int64_t                                         m_NextFlowOrder {0};
+    mutable bool                                            m_FlowOrderValid {false};
     Context                         m_Context;
+    ExecutionPlan                   m_Plan;
+    std::unordered_set<ID_TYPE>     m_DirtyNodes;   // changed since the last run of m_Context
     bool                            m_StyleLight {false};
     bool                            m_IsOpen {false};
+    bool                            m_UseArena {false};
 
     // Node Time info
     int64_t                         m_TimeStamp {-1};
@@ -424,10 +689,10 @@ namespace BluePrint
 IMGUI_API void GetVersion(int& major, int& minor, int& patch, int& build);
 } // namespace BluePrint
 
-# define BP_NODE(type, node_version, api_version, node_type, node_style, node_catalog) \
+# define BP_NODE(type, node_version, api_version, node_type, node_style, node_catalog, ...) \
     static ::BluePrint::NodeTypeInfo GetStaticTypeInfo() \
     { \
-        return \
+        ::BluePrint::NodeTypeInfo info \
         { \
             fnv1a_hash_32(#type + string("*") + node_catalog), \
             #type, \
@@ -441,17 +706,25 @@ IMGUI_API void GetVersion(int& major, int& minor, int& patch, int& build);
             node_catalog, \
             [](::BluePrint::BP* blueprint) -> ::BluePrint::Node* { return new type(blueprint); } \
         }; \
+        info.SetCapabilities(__VA_ARGS__); \
+        return info; \
     } \
     \
     ::BluePrint::NodeTypeInfo GetTypeInfo() const override \
     { \
         return GetStaticTypeInfo(); \
+    } \
+    \
+    uint32_t GetFlags() const override \
+    { \
+        static const uint32_t flags = GetStaticTypeInfo().m_Flags; \
+        return flags; \
     }
 
-# define BP_NODE_WITH_NAME(type, name, author, node_version, api_version, node_type, node_style, node_catalog) \
+# define BP_NODE_WITH_NAME(type, name, author, node_version, api_version, node_type, node_style, node_catalog, ...) \
     static ::BluePrint::NodeTypeInfo GetStaticTypeInfo() \
     { \
-        return \
+        ::BluePrint::NodeTypeInfo info \
         { \
             fnv1a_hash_32(#type + string("*") + node_catalog), \
             #type, \
@@ -465,11 +738,19 @@ IMGUI_API void GetVersion(int& major, int& minor, int& patch, int& build);
             node_catalog, \
             [](::BluePrint::BP* blueprint) -> ::BluePrint::Node* { return new type(blueprint); } \
         }; \
+        info.SetCapabilities(__VA_ARGS__); \
+        return info; \
     } \
     \
     ::BluePrint::NodeTypeInfo GetTypeInfo() const override \
     { \
         return GetStaticTypeInfo(); \
+    } \
+    \
+    uint32_t GetFlags() const override \
+    { \
+        static const uint32_t flags = GetStaticTypeInfo().m_Flags; \
+        return flags; \
     }
 
 #if defined(_WIN32)
@@ -478,7 +759,7 @@ IMGUI_API void GetVersion(int& major, int& minor, int& patch, int& build);
 #define EXPORT
 #endif
 
-# define BP_NODE_DYNAMIC(type, author, node_version, _api_version, node_type, node_style, node_catalog) \
+# define BP_NODE_DYNAMIC(type, author, node_version, _api_version, node_type, node_style, node_catalog, ...) \
     extern "C" EXPORT int32_t version() { \
         return VERSION_BLUEPRINT; \
     } \
@@ -487,7 +768,7 @@ IMGUI_API void GetVersion(int& major, int& minor, int& patch, int& build);
     } \
     \
     extern "C" EXPORT BluePrint::NodeTypeInfo* create() { \
-        return new BluePrint::NodeTypeInfo\
+        auto info = new BluePrint::NodeTypeInfo\
         ( \
             BluePrint::fnv1a_hash_32(#type + string("*") + node_catalog), \
             #type, \
@@ -501,13 +782,17 @@ IMGUI_API void GetVersion(int& major, int& minor, int& patch, int& build);
             node_catalog, \
             [](::BluePrint::BP* blueprint) -> ::BluePrint::Node* { return new BluePrint::type(blueprint); } \
         ); \
+        info->m_Flags = BluePrint::type::GetStaticTypeInfo().m_Flags; \
+        info->m_Cost = BluePrint::type::GetStaticTypeInfo().m_Cost; \
+        info->SetCapabilities(__VA_ARGS__); \
+        return info; \
     } \
     \
     extern "C" EXPORT void destroy(BluePrint::NodeTypeInfo* pObj) { \
         delete pObj; \
     }
 
-# define BP_NODE_DYNAMIC_WITH_NAME(type, name, author, node_version, _api_version, node_type, node_style, node_catalog) \
+# define BP_NODE_DYNAMIC_WITH_NAME(type, name, author, node_version, _api_version, node_type, node_style, node_catalog, ...) \
     extern "C" EXPORT int32_t version() { \
         return VERSION_BLUEPRINT; \
     } \
@@ -516,7 +801,7 @@ IMGUI_API void GetVersion(int& major, int& minor, int& patch, int& build);
     } \
     \
     extern "C" EXPORT BluePrint::NodeTypeInfo* create() { \
-        return new BluePrint::NodeTypeInfo\
+        auto info = new BluePrint::NodeTypeInfo\
         ( \
             BluePrint::fnv1a_hash_32(#type + string("*") + node_catalog), \
             #type, \
@@ -530,6 +815,10 @@ IMGUI_API void GetVersion(int& major, int& minor, int& patch, int& build);
             node_catalog, \
             [](::BluePrint::BP* blueprint) -> ::BluePrint::Node* { return new BluePrint::type(blueprint); } \
         ); \
+        info->m_Flags = BluePrint::type::GetStaticTypeInfo().m_Flags; \
+        info->m_Cost = BluePrint::type::GetStaticTypeInfo().m_Cost; \
+        info->SetCapabilities(__VA_ARGS__); \
+        return info; \
     } \
     \
     extern "C" EXPORT void destroy(BluePrint::NodeTypeInfo* pObj) { \
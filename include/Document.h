@@ -76,10 +76,12 @@ struct IMGUI_API Document
     imgui_json::value Serialize() const;
 
     static int Deserialize(const imgui_json::value& value, Document& result);
+    static int Deserialize(const BinaryDocument& document, Document& result);
 
     int  Load(std::string path);
     int  Import(std::string path, ImVec2 pos);
     bool Save(std::string path) const;
+    bool SaveBinary(std::string path) const;    // Load/Import tell it from json by the magic
     bool Save() const;
 
     bool Undo();
@@ -0,0 +1,54 @@
+#pragma once
+#include <stddef.h>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <deque>
+#include <vector>
+#include <chrono>
+#include <imgui.h>
+#include <TimerWheel.h>
+
+namespace BluePrint
+{
+// Fixed pool of worker threads with one run queue, Context::Execute submits its run loop here
+// and Context::Prefetch its input subtrees as nested tasks. Timed tasks resume suspended runs.
+struct IMGUI_API Executor
+{
+    using Task = std::function<void()>;
+
+    Executor(size_t workers = 0);   // 0 means one worker per hardware thread
+    ~Executor();
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    std::shared_future<void> Submit(Task task, bool nested = false);    // nested tasks are short and may be run by a thread in Wait
+    std::shared_future<void> SubmitAt(std::chrono::steady_clock::time_point time, Task task);    // queued once time has passed
+    void Wait(const std::shared_future<void>& future);                  // runs queued nested tasks until future is ready
+
+    void SetWorkerCount(size_t workers);    // shrinking waits for the retired workers to finish their current task
+    size_t GetWorkerCount() const;
+
+    static Executor& GetDefault();
+
+private:
+    struct Job
+    {
+        Task    m_Task;
+        bool    m_Nested {false};
+    };
+
+    void WorkerLoop(size_t index);
+
+    std::vector<std::thread>    m_Workers;
+    std::deque<Job>             m_Queue;
+    TimerWheel                  m_Timers;       // timed tasks, moved to m_Queue once due
+    mutable std::mutex          m_Mutex;
+    std::condition_variable     m_Condition;
+    size_t                      m_WorkerTarget {0};
+    bool                        m_Quit {false};
+};
+} // namespace BluePrint
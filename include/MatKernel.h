@@ -0,0 +1,26 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <imgui.h>
+#include <immat.h>
+
+namespace BluePrint
+{
+// Element-wise ImMat arithmetic for the arithmetic nodes, vectorized with AVX2/SSE4.1/NEON picked at runtime.
+// Int8 is treated as unsigned and Int8/Int16 saturate, division follows DivNode (x / 0 gives the type max,
+// floating point adds 1e-10 to the divisor). A broadcast value that is no element of an integer mat (a fraction,
+// out of range) is applied in double and only the result saturates. Only CPU mats are handled, anything else
+// gives an empty mat.
+enum class MatOp : int32_t
+{
+    Add,
+    Sub,
+    Mul,
+    Div
+};
+
+IMGUI_API ImGui::ImMat MatBinary(MatOp op, const ImGui::ImMat& a, const ImGui::ImMat& b);  // same shape, type and layout
+IMGUI_API ImGui::ImMat MatBinary(MatOp op, const ImGui::ImMat& a, double b);               // b applied to every element
+IMGUI_API bool MatCompare(const ImGui::ImMat& a, const ImGui::ImMat& b, int32_t& result);  // element order like string compare
+IMGUI_API const char* MatKernelName();  // instruction set in use
+} // namespace BluePrint
@@ -70,6 +70,21 @@ struct BP;
 struct Node;
 struct Pin;
 struct Context;
+// Node capability flags, declared by BP_NODE and consumed by caches and schedulers
+#define NODE_FLAG_NONE          (0)
+#define NODE_FLAG_PURE          (1<<0)  // no side effects, outputs depend on inputs and settings only. Never on flow control nodes
+#define NODE_FLAG_THREAD_SAFE   (1<<1)  // may execute on several threads or contexts at once
+#define NODE_FLAG_DETERMINISTIC (1<<2)  // same inputs give same outputs within a step
+#define NODE_FLAGS_API_VERSION  ((1 << 24) | (3 << 16)) // external nodes built before this API carry no flags
+
+enum class NodeCost:int32_t 
+{
+    Unknown = 0,
+    Trivial,        // scalar arithmetic, not worth a task
+    Light,
+    Heavy,          // image processing and the like, worth running in parallel
+};
+
 struct NodeTypeInfo
 {
     using Factory = Node*(*)(BP* blueprint);
@@ -102,28 +117,52 @@ struct NodeTypeInfo
 
     std::string     m_Url;
 
+    uint32_t        m_Flags {NODE_FLAG_NONE};
+    NodeCost        m_Cost {NodeCost::Unknown};
+
+    void SetCapabilities() {}
+    void SetCapabilities(uint32_t flags, NodeCost cost = NodeCost::Unknown) { m_Flags = flags; m_Cost = cost; }
+
 	// for dynamic loading of the object
 	typedef int32_t version_t();
 	typedef NodeTypeInfo* create_t();
 	typedef void destroy_t(NodeTypeInfo*);
 };
 
+// Per execution state of a node, every Context running the graph holds its own block for each node
+struct IMGUI_API NodeState
+{
+    virtual ~NodeState() = default;
+
+    // for Node banchmark
+    uint64_t        m_Tick {0};
+    uint64_t        m_Hits {0};
+    double          m_NodeTimeMs    {0.f};  // last Execute in this context
+    // for avg banchmark
+    int             m_HitCount      {0};
+    double          m_CountTimeMs   {0.f};
+    double          m_AvgTimeMs     {0.f};
+    // last Execute result, replayed by incremental reruns while nothing upstream changed
+    FlowPin         m_Next          {};
+    ID_TYPE         m_Entry         {0};
+    uint32_t        m_Epoch         {0};
+    bool            m_Reusable      {false};
+};
+
 struct IMGUI_API Node
 {
     Node(BP* blueprint);
     virtual ~Node() = default;
 
+    BP_ARENA_ALLOCATED
+
     template <typename T>
     unique_ptr<T> CreatePin(std::string name = "");
     unique_ptr<Pin> CreatePin(PinType pinType, std::string name = "");
     Pin * NewPin(PinType pinType, std::string name = "");
     
-    virtual void Reset(Context& context) // Reset state of the node before execution. Allows to set initial state for the specified execution context.
-    {
-        m_Tick = 0;
-        m_Hits = 0;
-        m_NodeTimeMs = 0;
-    }
+    virtual void Reset(Context& context); // Reset state of the node before execution. Allows to set initial state for the specified execution context.
+    virtual NodeState* CreateState() const { return new NodeState(); } // Allocate per context state, nodes with execution state return their own NodeState type
 
     virtual void Update() {}  // Update Node
     virtual void PreLoad() {} // pre-load node resource
@@ -166,6 +205,10 @@ struct IMGUI_API Node
         return pin.GetValue();
     }
 
+    virtual bool IsMemoizable() const { return GetFlags() & NODE_FLAG_DETERMINISTIC; } // EvaluatePin results may be reused within one step
+    virtual bool IsReusable() const { return (GetFlags() & (NODE_FLAG_PURE | NODE_FLAG_DETERMINISTIC)) == (NODE_FLAG_PURE | NODE_FLAG_DETERMINISTIC); } // Execute result may be replayed by BP::Rerun when no input changed
+    virtual bool IsThreadSafe() const { return GetFlags() & NODE_FLAG_THREAD_SAFE; } // Pins may be evaluated on worker threads
+
     virtual Pin* FindPin(std::string name)
     {
         auto inpins = GetInputPins();
@@ -231,6 +274,8 @@ struct IMGUI_API Node
     virtual ID_TYPE         GetTypeID() const;
     virtual NodeStyle       GetStyle() const;
     virtual std::string     GetCatalog() const;
+    virtual uint32_t        GetFlags() const;
+    virtual NodeCost        GetCost() const;
     virtual std::string     GetName() const;
     virtual void            SetName(std::string name);
     virtual void            SetBreakPoint(bool breaken);
@@ -242,6 +287,7 @@ struct IMGUI_API Node
 
     virtual span<Pin*>      GetInputPins() { return {}; } // Returns list of input pins of the node
     virtual span<Pin*>      GetOutputPins() { return {}; } // Returns list of output pins of the node
+    void                    PinsChanged(); // Call when GetInputPins/GetOutputPins return other pins, stores the side in every listed pin
     virtual Pin*            GetAutoLinkInputFlowPin() { return nullptr; } // Return auto link flow pin which as input
     virtual Pin*            GetAutoLinkOutputFlowPin() { return nullptr; } // Return auto link flow pin which as output
     virtual vector<Pin*>    GetAutoLinkInputDataPin() { return {}; } // Return auto link data pin which as input
@@ -1,5 +1,6 @@
 #pragma once
 #include <iostream>
+#include <atomic>
 #include <BluePrint.h>
 #include <immat.h>
 
@@ -12,6 +13,11 @@
 #define PIN_FLAG_EXPORTED   (1<<5)
 #define PIN_FLAG_PUBLICIZED (1<<6)
 #define PIN_FLAG_FORCESHOW  (1<<7)
+// Side of the node the pin is listed on, set by Node::PinsChanged, never saved
+#define PIN_FLAG_SIDE_KNOWN (1<<8)
+#define PIN_FLAG_INPUT_SIDE (1<<9)
+#define PIN_FLAG_OUTPUT_SIDE (1<<10)
+#define PIN_FLAG_SIDE_MASK  (PIN_FLAG_SIDE_KNOWN | PIN_FLAG_INPUT_SIDE | PIN_FLAG_OUTPUT_SIDE)
 
 struct PinExModuleInfo;
 
@@ -54,28 +60,82 @@ private:
     const std::string   m_Name;
 };
 
+// Intrusively refcounted, PinValue and PinEx hold references instead of copies.
+// Created with one reference, the last Release hands it to Recycle.
 struct PinValueEx
 {
     PinValueEx() {}
-    virtual ~PinValueEx() {}
 
     virtual const std::type_info& GetTypeInfo() const = 0;
     virtual PinValueEx* CreateCopy() const = 0;
     virtual bool CheckIdentical(const PinValueEx& r) const = 0;
     virtual void* GetVoidPtr() const = 0;
+
+    PinValueEx* Retain() { m_Refs.fetch_add(1, std::memory_order_relaxed); return this; }
+    void Release() { if (m_Refs.fetch_sub(1, std::memory_order_acq_rel) == 1) Recycle(); }
+
+protected:
+    virtual ~PinValueEx() {}    // only the last Release ends it
+    virtual void Recycle() { delete this; }
+
+    std::atomic<uint32_t> m_Refs {1};
 };
 
+// Refcounted out of line payload of PinValue, copies share it and it is never written after construction
+template <typename T>
+struct PinValueBox
+{
+    explicit PinValueBox(T value): m_Box(new Box{{1}, std::move(value)}) {}
+    PinValueBox(const PinValueBox& other): m_Box(other.m_Box) { if (m_Box) m_Box->m_Refs.fetch_add(1, std::memory_order_relaxed); }
+    PinValueBox(PinValueBox&& other) noexcept: m_Box(other.m_Box) { other.m_Box = nullptr; }
+    PinValueBox& operator=(PinValueBox other) noexcept { std::swap(m_Box, other.m_Box); return *this; }
+    ~PinValueBox() { if (m_Box && m_Box->m_Refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete m_Box; }
+
+    const T& Get() const
+    {
+        static const T empty {};
+        return m_Box ? m_Box->m_Value : empty;
+    }
+
+private:
+    struct Box
+    {
+        std::atomic<uint32_t>   m_Refs;
+        T                       m_Value;
+    };
+    Box* m_Box {nullptr};
+};
+
+// Maps a value type to what PinValue stores for it
+template <typename T>
+struct PinValueStorage
+{
+    using Type = T;
+    static T& Get(T& value) { return value; }
+    static const T& Get(const T& value) { return value; }
+};
+
+template <typename T>
+struct PinValueBoxed
+{
+    using Type = PinValueBox<T>;
+    static const T& Get(const Type& value) { return value.Get(); }
+};
+template <> struct PinValueStorage<std::string>         : PinValueBoxed<std::string> {};
+template <> struct PinValueStorage<ImGui::ImMat>        : PinValueBoxed<ImGui::ImMat> {};
+template <> struct PinValueStorage<imgui_json::array>   : PinValueBoxed<imgui_json::array> {};
+
 struct LinkQueryResult;
 struct FlowPin;
+// Tagged value, strings, matrices and arrays are boxed so copying a PinValue never copies them
 struct PinValue
 {
-    using ValueType = variant<monostate, FlowPin*, bool, int32_t, int64_t, float, double, std::string, uintptr_t, ImVec2, ImVec4, ImGui::ImMat, imgui_json::array, PinValueEx*>;
+    using ValueType = variant<monostate, FlowPin*, bool, int32_t, int64_t, float, double, PinValueBox<std::string>, uintptr_t, ImVec2, ImVec4, PinValueBox<ImGui::ImMat>, PinValueBox<imgui_json::array>, PinValueEx*>;
 
     PinValue() = default;
-    PinValue(const PinValue&) = default;
-    PinValue(PinValue&&) = default;
-    PinValue& operator=(const PinValue&) = default;
-    PinValue& operator=(PinValue&&) = default;
+    PinValue(const PinValue& other): m_Value(other.m_Value) { RetainEx(); }
+    PinValue(PinValue&& other) noexcept: m_Value(std::move(other.m_Value)) { other.m_Value = monostate(); }
+    PinValue& operator=(PinValue other) noexcept { std::swap(m_Value, other.m_Value); return *this; }
 
     PinValue(FlowPin* pin): m_Value(pin) {}
     PinValue(bool value): m_Value(value) {}
@@ -84,48 +144,72 @@ struct PinValue
     PinValue(float value): m_Value(value) {}
     PinValue(double value): m_Value(value) {}
     PinValue(uintptr_t value): m_Value(value) {}
-    PinValue(std::string&& value): m_Value(std::move(value)) {}
-    PinValue(const std::string& value): m_Value(value) {}
-    PinValue(const char* value): m_Value(std::string(value)) {}
+    PinValue(std::string value): m_Value(PinValueBox<std::string>(std::move(value))) {}
+    PinValue(const char* value): PinValue(std::string(value)) {}
     PinValue(const ImVec2 value): m_Value(value) {}
     PinValue(const ImVec4 value): m_Value(value) {}
-    PinValue(ImGui::ImMat value): m_Value(value) {}
-    PinValue(imgui_json::array value): m_Value(value) {}
-    PinValue(PinValueEx* valex)
+    PinValue(ImGui::ImMat value): m_Value(PinValueBox<ImGui::ImMat>(std::move(value))) {}
+    PinValue(imgui_json::array value): m_Value(PinValueBox<imgui_json::array>(std::move(value))) {}
+    PinValue(PinValueEx* valex): m_Value(valex) { RetainEx(); }    // shares valex
+    static PinValue Adopt(PinValueEx* valex)                        // takes over the caller's reference
     {
-        if (valex)
-            m_Value = valex->CreateCopy();
-        else
-            m_Value = valex;
+        PinValue value;
+        value.m_Value = valex;
+        return value;
     }
-    PinValue(PinValueEx*&& valex): m_Value(std::move(valex)) {}
 
     ~PinValue()
     {
         if (GetType() == PinType::Custom)
         {
-            PinValueEx* pPinValEx = As<PinValueEx*>();
-            delete pPinValEx;
+            if (auto pPinValEx = get<PinValueEx*>(m_Value))
+                pPinValEx->Release();
         }
     }
 
     PinType GetType() const { return static_cast<PinType>(m_Value.index()); }
 
+    // Boxed payloads are read-only, As gives a const reference to them
     template <typename T>
-    T& As()
+    decltype(auto) As()
     {
-        return get<T>(m_Value);
+        return PinValueStorage<T>::Get(get<typename PinValueStorage<T>::Type>(m_Value));
     }
 
     template <typename T>
     const T& As() const
     {
-        return get<T>(m_Value);
+        return PinValueStorage<T>::Get(get<typename PinValueStorage<T>::Type>(m_Value));
     }
 
 private:
+    void RetainEx()
+    {
+        if (GetType() == PinType::Custom)
+        {
+            if (auto pPinValEx = get<PinValueEx*>(m_Value))
+                pPinValEx->Retain();
+        }
+    }
+
     ValueType m_Value;
 };
+static_assert(sizeof(PinValue) <= sizeof(ImVec4) + sizeof(void*), "PinValue should not grow past an inline ImVec4");
+
+// Typed read of a PinValue, shares the value so a boxed payload is read in place instead of copied
+template <typename T>
+struct PinValueRef
+{
+    explicit PinValueRef(PinValue value): m_Value(std::move(value)) {}
+
+    const T& Get() const { return m_Value.As<T>(); }
+    operator const T&() const { return Get(); }
+    const T& operator*() const { return Get(); }
+    const T* operator->() const { return &Get(); }
+
+private:
+    PinValue m_Value;
+};
 
 struct Node;
 struct BP;
@@ -134,6 +218,8 @@ struct IMGUI_API Pin
     Pin(Node* node, PinType type, std::string name = "");
     virtual ~Pin();
 
+    BP_ARENA_ALLOCATED
+
     virtual bool     SetValueType(PinType type) { return m_Type == type; }  // By default, type of held value cannot be changed
     virtual PinType  GetValueType() const;                                  // Returns type of held value (may be different from GetType() for Any pin)
     virtual bool     SetValue(const PinValue& value) { return false; }      // Sets new value to be held by the pin (not all allow data to be modified)
@@ -170,6 +256,22 @@ struct IMGUI_API Pin
 
     // For Bridge/Shadow Pin
     ID_TYPE         m_MappedPin {static_cast<ID_TYPE>(0)};
+
+    // Value slot in Context, assigned by BP::Compile
+    int32_t         m_Slot      {-1};
+
+private:
+    ID_TYPE SideFlags() const { return m_Flags; }
+
+    // Set on the pin MakePinID registered. Copies (FlowPin returned by Execute, kept in node states)
+    // start unregistered and never touch their node again, it may be gone when they die
+    struct Registration
+    {
+        Registration() = default;
+        Registration(const Registration&) {}
+        Registration& operator=(const Registration&) { return *this; }
+        bool m_Set {false};
+    } m_Registration;
 };
 
 template<class T>
@@ -196,23 +298,28 @@ public:
         m_Shptr = std::shared_ptr<T>(r.m_Shptr);
     }
 
-    virtual ~PinValueExImpl()
-    {
-        // std::cout << "Delete <PinValueExImpl*>(" << this << "), holding ptr (" << m_Shptr.get() << ")." << std::endl;
-    }
-
     T* GetValuePtr() const
     { return m_Shptr.get(); }
 
     const std::type_info& GetTypeInfo() const override
     { return typeid(T); }
 
+    // Taken from the pool of this type when it has one spare
+    static PinValueExImpl<T>* Create(std::shared_ptr<T> ValueShptr)
+    {
+        auto pool = Pool();
+        if (!pool || pool->m_Free.empty())
+            return new PinValueExImpl<T>(ValueShptr);
+        auto res = pool->m_Free.back();
+        pool->m_Free.pop_back();
+        res->m_Refs.store(1, std::memory_order_relaxed);
+        res->m_Shptr = std::move(ValueShptr);
+        return res;
+    }
+
     PinValueEx* CreateCopy() const override
     {
-        // PinValueExImpl<T>* res = new PinValueExImpl<T>(*this);
-        // std::cout << "Create <PinValueExImpl*>(" << res << "), holding ptr (" << GetVoidPtr() << ")." << std::endl;
-        // return res;
-        return new PinValueExImpl<T>(*this);
+        return Create(m_Shptr);
     }
 
     bool CheckIdentical(const PinValueEx& r) const override
@@ -229,7 +336,45 @@ public:
         return m_Shptr.get();
     }
 
+protected:
+    ~PinValueExImpl() override
+    {
+        // std::cout << "Delete <PinValueExImpl*>(" << this << "), holding ptr (" << m_Shptr.get() << ")." << std::endl;
+    }
+
+    void Recycle() override
+    {
+        m_Shptr.reset();
+        auto pool = Pool();
+        if (pool && pool->m_Free.size() < POOL_SIZE)
+            pool->m_Free.push_back(this);
+        else
+            delete this;
+    }
+
 private:
+    static constexpr size_t POOL_SIZE = 64;
+
+    // Per thread, so neither Create nor Recycle takes a lock.
+    // Values released by other thread locals after the pool is gone fall back to new/delete.
+    struct FreeList
+    {
+        ~FreeList() { PoolDestroyed() = true; for (auto p : m_Free) delete p; }
+        std::vector<PinValueExImpl<T>*> m_Free;
+    };
+    static bool& PoolDestroyed()
+    {
+        static thread_local bool destroyed {false};
+        return destroyed;
+    }
+    static FreeList* Pool()
+    {
+        if (PoolDestroyed())
+            return nullptr;
+        static thread_local FreeList pool;
+        return &pool;
+    }
+
     std::shared_ptr<T>  m_Shptr;
 };
 
@@ -241,7 +386,7 @@ public:
     {
         if (m_pPinValueEx)
         {
-            delete m_pPinValueEx;
+            m_pPinValueEx->Release();
             m_pPinValueEx = nullptr;
         }
     }
@@ -260,18 +405,18 @@ public:
 
     void SetPinValueEx(const PinValueEx* pPinValueEx)
     {
-        if (m_pPinValueEx && pPinValueEx && m_pPinValueEx->CheckIdentical(*pPinValueEx)) 
+        if (m_pPinValueEx == pPinValueEx || (m_pPinValueEx && pPinValueEx && m_pPinValueEx->CheckIdentical(*pPinValueEx)))
         {
             return;
         }
         if (m_pPinValueEx) 
         {
-            delete m_pPinValueEx;
+            m_pPinValueEx->Release();
             m_pPinValueEx = nullptr;
         }
         if (pPinValueEx)
         {
-            m_pPinValueEx = pPinValueEx->CreateCopy();
+            m_pPinValueEx = const_cast<PinValueEx*>(pPinValueEx)->Retain();
         }
     }
 
@@ -294,6 +439,14 @@ public:
     }
 
 protected:
+    // For SetValuePtr implementations, takes over the reference of a new value, e.g. PinValueExImpl<T>::Create(ptr)
+    void ResetPinValueEx(PinValueEx* pPinValueEx)
+    {
+        if (m_pPinValueEx)
+            m_pPinValueEx->Release();
+        m_pPinValueEx = pPinValueEx;
+    }
+
     PinValueEx*     m_pPinValueEx   {nullptr};
 };
 
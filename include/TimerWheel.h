@@ -0,0 +1,51 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <vector>
+#include <chrono>
+#include <imgui.h>
+
+namespace BluePrint
+{
+// Hierarchical timer wheel on the monotonic clock, Executor keeps its timed tasks here.
+// Adding a timer is O(1), timers far out cascade down one level at a time as the wheel turns.
+// Not thread-safe, the owner serializes access.
+struct IMGUI_API TimerWheel
+{
+    using Clock     = std::chrono::steady_clock;
+    using Callback  = std::function<void()>;
+
+    static constexpr int    LEVELS      = 4;
+    static constexpr int    SLOT_BITS   = 6;
+    static constexpr size_t SLOTS       = size_t(1) << SLOT_BITS;
+
+    TimerWheel(Clock::duration tick = std::chrono::milliseconds(1));
+
+    void Add(Clock::time_point time, Callback callback);
+    void Advance(Clock::time_point now, std::vector<Callback>& expired);    // turn the wheel to now, due callbacks are appended in deadline order
+    Clock::time_point NextExpiry() const;   // time worth waking up for, Clock::time_point::max() when empty
+    bool Empty() const { return m_Count == 0; }
+    size_t Size() const { return m_Count; }
+
+private:
+    struct Timer
+    {
+        uint64_t    m_Tick;
+        Callback    m_Callback;
+    };
+
+    uint64_t ToTick(Clock::time_point time) const;
+    Clock::time_point ToTime(uint64_t tick) const;
+    void Place(Timer&& timer);
+    void Cascade(int level);
+
+    Clock::time_point   m_Origin;
+    Clock::duration     m_Tick;
+    uint64_t            m_Current {0};  // last tick the wheel has turned to
+    size_t              m_Count {0};
+    std::vector<Timer>  m_Slots[LEVELS][SLOTS];
+    std::vector<Timer>  m_Overflow;     // beyond the top level, placed again when it wraps
+    std::vector<Timer>  m_Due;          // added at or before the current tick
+};
+} // namespace BluePrint
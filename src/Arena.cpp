@@ -0,0 +1,124 @@
+#include <Arena.h>
+#include <algorithm>
+
+namespace BluePrint
+{
+static thread_local Arena* s_CurrentArena = nullptr;
+
+static constexpr size_t CHUNK_ALIGN = 64;
+
+// In front of every block from Arena::New, tells Delete where the memory came from
+struct alignas(std::max_align_t) ArenaHeader
+{
+    Arena*      m_Arena;
+    uint32_t    m_Offset;   // from block start to object
+    uint32_t    m_Align;
+};
+
+static inline size_t AlignUp(size_t value, size_t align)
+{
+    return (value + align - 1) & ~(align - 1);
+}
+
+Arena::~Arena()
+{
+    // objects still alive keep their memory, a leak is better than a dangling node. Drop avoids both
+    if (m_Refs.load(std::memory_order_acquire) <= 1)
+        FreeChunks();
+}
+
+void* Arena::Allocate(size_t size, size_t align)
+{
+    auto head = m_Head ? reinterpret_cast<char*>(AlignUp(reinterpret_cast<uintptr_t>(m_Head), align)) : nullptr;
+    if (!head || head + size > m_End)
+    {
+        // a block larger than a chunk gets a chunk of its own
+        auto chunkSize = std::max(CHUNK_SIZE, AlignUp(size + align, CHUNK_ALIGN));
+        auto data = static_cast<char*>(::operator new(chunkSize, std::align_val_t(CHUNK_ALIGN)));
+        m_Chunks.push_back({data, chunkSize});
+        m_Capacity += chunkSize;
+        m_Head = data;
+        m_End = data + chunkSize;
+        head = reinterpret_cast<char*>(AlignUp(reinterpret_cast<uintptr_t>(m_Head), align));
+    }
+    m_Used += static_cast<size_t>(head + size - m_Head);
+    m_Head = head + size;
+    return head;
+}
+
+bool Arena::Release()
+{
+    if (Live() != 0)
+        return false;
+    FreeChunks();
+    return true;
+}
+
+void Arena::Drop()
+{
+    if (m_Refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete this;
+}
+
+void Arena::FreeChunks()
+{
+    for (auto& chunk : m_Chunks)
+        ::operator delete(chunk.m_Data, std::align_val_t(CHUNK_ALIGN));
+    m_Chunks.clear();
+    m_Head = m_End = nullptr;
+    m_Used = m_Capacity = 0;
+}
+
+void* Arena::New(size_t size, size_t align)
+{
+    align = std::max(align, alignof(ArenaHeader));
+    auto offset = AlignUp(sizeof(ArenaHeader), align);
+    auto arena = s_CurrentArena;
+    char* block = nullptr;
+    if (arena)
+    {
+        block = static_cast<char*>(arena->Allocate(offset + size, align));
+        arena->m_Refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+        block = static_cast<char*>(::operator new(offset + size, std::align_val_t(align)));
+
+    auto object = block + offset;
+    auto header = reinterpret_cast<ArenaHeader*>(object) - 1;
+    header->m_Arena  = arena;
+    header->m_Offset = static_cast<uint32_t>(offset);
+    header->m_Align  = static_cast<uint32_t>(align);
+    return object;
+}
+
+void Arena::Delete(void* ptr)
+{
+    if (!ptr)
+        return;
+    auto header = static_cast<ArenaHeader*>(ptr) - 1;
+    if (header->m_Arena)
+    {
+        // the last object of a dropped arena takes it along
+        if (header->m_Arena->m_Refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete header->m_Arena;
+    }
+    else
+        ::operator delete(static_cast<char*>(ptr) - header->m_Offset, std::align_val_t(header->m_Align));
+}
+
+Arena* Arena::Current()
+{
+    return s_CurrentArena;
+}
+
+ArenaScope::ArenaScope(Arena* arena)
+    : m_Previous(s_CurrentArena)
+{
+    s_CurrentArena = arena;
+}
+
+ArenaScope::~ArenaScope()
+{
+    s_CurrentArena = m_Previous;
+}
+} // namespace BluePrint
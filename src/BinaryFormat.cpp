@@ -0,0 +1,487 @@
+#include <BinaryFormat.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#if defined(_WIN32)
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace BluePrint
+{
+static inline uint64_t AlignUp8(uint64_t value)
+{
+    return (value + 7) & ~uint64_t(7);
+}
+
+// member of an object record by key, BP_BINARY_NONE when missing
+static uint32_t FindMember(const BinaryValue* values, const BinaryString* strings, const char* stringData, uint32_t object, const char* key)
+{
+    auto& value = values[object];
+    if (value.m_Type != BinaryValueType::Object)
+        return BP_BINARY_NONE;
+    auto length = strlen(key);
+    for (uint32_t i = 0; i < value.m_Children.m_Count; i++)
+    {
+        auto index = value.m_Children.m_First + i;
+        auto& name = strings[values[index].m_Key];
+        if (name.m_Length == length && memcmp(stringData + name.m_Offset, key, length) == 0)
+            return index;
+    }
+    return BP_BINARY_NONE;
+}
+
+static uint32_t MemberNumber(const BinaryValue* values, const BinaryString* strings, const char* stringData, uint32_t object, const char* key)
+{
+    auto index = FindMember(values, strings, stringData, object, key);
+    if (index == BP_BINARY_NONE || values[index].m_Type != BinaryValueType::Number)
+        return 0;
+    auto number = values[index].m_Number;
+    if (!(number >= 0 && number <= double(UINT32_MAX)))
+        return 0;
+    return static_cast<uint32_t>(number);
+}
+
+# pragma region Encoder
+struct BinaryEncoder
+{
+    std::vector<BinaryString>                   m_Strings;
+    std::string                                 m_StringData;
+    std::unordered_map<std::string, uint32_t>   m_StringIndex;
+    std::vector<BinaryValue>                    m_Values;
+    std::vector<BinaryNode>                     m_Nodes;
+    std::vector<BinaryPin>                      m_Pins;
+    std::vector<BinaryLink>                     m_Links;
+    std::deque<std::pair<uint32_t, const imgui_json::value*>> m_Pending;
+
+    uint32_t Intern(const std::string& string)
+    {
+        auto it = m_StringIndex.find(string);
+        if (it != m_StringIndex.end())
+            return it->second;
+        auto index = static_cast<uint32_t>(m_Strings.size());
+        m_Strings.push_back({static_cast<uint32_t>(m_StringData.size()), static_cast<uint32_t>(string.size())});
+        m_StringData.append(string);
+        m_StringData.push_back('\0');
+        m_StringIndex.emplace(string, index);
+        return index;
+    }
+
+    void Fill(uint32_t slot, const imgui_json::value& value, uint32_t key)
+    {
+        BinaryValue record {};
+        record.m_Key = key;
+        switch (value.type())
+        {
+            case imgui_json::type_t::object:
+                record.m_Type = BinaryValueType::Object;
+                m_Pending.emplace_back(slot, &value);
+                break;
+            case imgui_json::type_t::array:
+                record.m_Type = BinaryValueType::Array;
+                m_Pending.emplace_back(slot, &value);
+                break;
+            case imgui_json::type_t::string:
+                record.m_Type = BinaryValueType::String;
+                record.m_String = Intern(value.get<imgui_json::string>());
+                break;
+            case imgui_json::type_t::boolean:
+                record.m_Type = BinaryValueType::Boolean;
+                record.m_Boolean = value.get<imgui_json::boolean>() ? 1 : 0;
+                break;
+            case imgui_json::type_t::number:
+                record.m_Type = BinaryValueType::Number;
+                record.m_Number = value.get<imgui_json::number>();
+                break;
+            default:
+                record.m_Type = BinaryValueType::Null;
+                break;
+        }
+        m_Values[slot] = record;
+    }
+
+    // breadth first, so the members of every container get one contiguous run after their parent
+    void Encode(const imgui_json::value& root)
+    {
+        m_Values.resize(1);
+        Fill(0, root, BP_BINARY_NONE);
+        while (!m_Pending.empty())
+        {
+            auto [slot, value] = m_Pending.front();
+            m_Pending.pop_front();
+            auto first = static_cast<uint32_t>(m_Values.size());
+            uint32_t count = 0;
+            if (value->is_object())
+            {
+                auto& object = value->get<imgui_json::object>();
+                m_Values.resize(m_Values.size() + object.size());
+                for (auto& member : object)
+                    Fill(first + count++, member.second, Intern(member.first));
+            }
+            else
+            {
+                auto& array = value->get<imgui_json::array>();
+                m_Values.resize(m_Values.size() + array.size());
+                for (auto& item : array)
+                    Fill(first + count++, item, BP_BINARY_NONE);
+            }
+            m_Values[slot].m_Children.m_First = first;
+            m_Values[slot].m_Children.m_Count = count;
+        }
+    }
+
+    uint32_t Member(uint32_t object, const char* key) const
+    {
+        return FindMember(m_Values.data(), m_Strings.data(), m_StringData.data(), object, key);
+    }
+
+    void IndexPins(uint32_t node, uint32_t pins, bool output)
+    {
+        if (pins == BP_BINARY_NONE || m_Values[pins].m_Type != BinaryValueType::Array)
+            return;
+        auto& array = m_Values[pins].m_Children;
+        for (uint32_t i = 0; i < array.m_Count; i++)
+        {
+            auto pin = array.m_First + i;
+            if (m_Values[pin].m_Type != BinaryValueType::Object)
+                continue;
+            auto id = MemberNumber(m_Values.data(), m_Strings.data(), m_StringData.data(), pin, "id");
+            auto link = MemberNumber(m_Values.data(), m_Strings.data(), m_StringData.data(), pin, "link");
+            m_Pins.push_back({id, node, pin, output ? 1u : 0u});
+            if (link)
+                m_Links.push_back({id, link});
+        }
+    }
+
+    // node records for a Document ("document"/"blueprint"/"nodes") or a BP/group file ("nodes")
+    void IndexNodes()
+    {
+        auto nodes = Member(0, "nodes");
+        auto document = Member(0, "document");
+        if (document != BP_BINARY_NONE)
+        {
+            auto blueprint = Member(document, "blueprint");
+            if (blueprint != BP_BINARY_NONE)
+                nodes = Member(blueprint, "nodes");
+        }
+        if (nodes == BP_BINARY_NONE || m_Values[nodes].m_Type != BinaryValueType::Array)
+            return;
+        auto& array = m_Values[nodes].m_Children;
+        for (uint32_t i = 0; i < array.m_Count; i++)
+        {
+            auto node = array.m_First + i;
+            if (m_Values[node].m_Type != BinaryValueType::Object)
+                continue;
+            auto index = static_cast<uint32_t>(m_Nodes.size());
+            BinaryNode record {};
+            record.m_Value  = node;
+            record.m_ID     = MemberNumber(m_Values.data(), m_Strings.data(), m_StringData.data(), node, "id");
+            record.m_TypeID = MemberNumber(m_Values.data(), m_Strings.data(), m_StringData.data(), node, "type_id");
+            auto name = Member(node, "name");
+            record.m_Name = name != BP_BINARY_NONE && m_Values[name].m_Type == BinaryValueType::String ? m_Values[name].m_String : BP_BINARY_NONE;
+            m_Nodes.push_back(record);
+            IndexPins(index, Member(node, "input_pins"), false);
+            IndexPins(index, Member(node, "output_pins"), true);
+        }
+    }
+};
+# pragma endregion
+
+BinaryDocument::~BinaryDocument()
+{
+    Close();
+}
+
+bool BinaryDocument::Open(const std::string& path)
+{
+    Close();
+#if defined(_WIN32)
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+        return false;
+    auto size = static_cast<size_t>(file.tellg());
+    auto data = static_cast<uint8_t*>(::operator new(size ? size : 1, std::align_val_t(8)));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(data), size))
+    {
+        ::operator delete(data, std::align_val_t(8));
+        return false;
+    }
+    m_Data = data;
+    m_Size = size;
+    m_Mapped = false;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(BinaryHeader))
+    {
+        ::close(fd);
+        return false;
+    }
+    auto data = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+        return false;
+    m_Data = static_cast<const uint8_t*>(data);
+    m_Size = static_cast<size_t>(st.st_size);
+    m_Mapped = true;
+#endif
+    if (!Validate(m_Size))
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void BinaryDocument::Close()
+{
+    if (m_Data)
+    {
+#if defined(_WIN32)
+        ::operator delete(const_cast<uint8_t*>(m_Data), std::align_val_t(8));
+#else
+        if (m_Mapped)
+            ::munmap(const_cast<uint8_t*>(m_Data), m_Size);
+#endif
+    }
+    m_Data = nullptr;
+    m_Size = 0;
+    m_Mapped = false;
+    m_Header = nullptr;
+    m_Strings = nullptr;
+    m_StringData = nullptr;
+    m_Values = nullptr;
+    m_Nodes = nullptr;
+    m_Pins = nullptr;
+    m_Links = nullptr;
+}
+
+// One pass over the records, afterwards every index and range in the file can be used unchecked
+bool BinaryDocument::Validate(size_t size)
+{
+    if (size < sizeof(BinaryHeader))
+        return false;
+    auto header = reinterpret_cast<const BinaryHeader*>(m_Data);
+    if (header->m_Magic != BP_BINARY_MAGIC || header->m_Version > BP_BINARY_VERSION ||
+        header->m_HeaderSize < sizeof(BinaryHeader) || header->m_FileSize != size)
+        return false;
+
+    auto section = [&](uint64_t offset, uint64_t count, uint64_t stride)
+    {
+        return (offset & 7) == 0 && offset >= header->m_HeaderSize && offset <= size && count <= (size - offset) / stride;
+    };
+    if (!section(header->m_StringOffset, header->m_StringCount, sizeof(BinaryString)) ||
+        !section(header->m_StringDataOffset, header->m_StringDataSize, 1) ||
+        !section(header->m_ValueOffset, header->m_ValueCount, sizeof(BinaryValue)) ||
+        !section(header->m_NodeOffset, header->m_NodeCount, sizeof(BinaryNode)) ||
+        !section(header->m_PinOffset, header->m_PinCount, sizeof(BinaryPin)) ||
+        !section(header->m_LinkOffset, header->m_LinkCount, sizeof(BinaryLink)) ||
+        header->m_Root >= header->m_ValueCount)
+        return false;
+
+    auto strings = reinterpret_cast<const BinaryString*>(m_Data + header->m_StringOffset);
+    auto stringData = reinterpret_cast<const char*>(m_Data + header->m_StringDataOffset);
+    for (uint32_t i = 0; i < header->m_StringCount; i++)
+    {
+        auto end = uint64_t(strings[i].m_Offset) + strings[i].m_Length;
+        if (end >= header->m_StringDataSize || stringData[end] != '\0')
+            return false;
+    }
+
+    // Save writes containers breadth first from the root, so their member runs follow each other
+    // without gaps or overlaps. Anything else could share members or nest without bound.
+    if (header->m_Root != 0)
+        return false;
+    auto values = reinterpret_cast<const BinaryValue*>(m_Data + header->m_ValueOffset);
+    std::vector<uint16_t> depths(header->m_ValueCount, 0);
+    uint64_t nextChild = 1;
+    for (uint32_t i = 0; i < header->m_ValueCount; i++)
+    {
+        auto& value = values[i];
+        if (value.m_Key != BP_BINARY_NONE && value.m_Key >= header->m_StringCount)
+            return false;
+        switch (value.m_Type)
+        {
+            case BinaryValueType::Null:
+            case BinaryValueType::Boolean:
+            case BinaryValueType::Number:
+                break;
+            case BinaryValueType::String:
+                if (value.m_String >= header->m_StringCount)
+                    return false;
+                break;
+            case BinaryValueType::Object:
+            case BinaryValueType::Array:
+            {
+                // members always come after their container, which also rules out cycles
+                auto& children = value.m_Children;
+                if (!children.m_Count)
+                    break;
+                if (children.m_First <= i || children.m_First != nextChild || nextChild + children.m_Count > header->m_ValueCount)
+                    return false;
+                if (depths[i] + 1 > BP_BINARY_MAX_DEPTH)
+                    return false;
+                nextChild += children.m_Count;
+                for (uint32_t c = 0; c < children.m_Count; c++)
+                {
+                    auto& child = values[children.m_First + c];
+                    if ((value.m_Type == BinaryValueType::Object) == (child.m_Key == BP_BINARY_NONE))
+                        return false;
+                    depths[children.m_First + c] = static_cast<uint16_t>(depths[i] + 1);
+                }
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    if (nextChild != header->m_ValueCount)
+        return false;
+
+    auto nodes = reinterpret_cast<const BinaryNode*>(m_Data + header->m_NodeOffset);
+    for (uint32_t i = 0; i < header->m_NodeCount; i++)
+        if (nodes[i].m_Value >= header->m_ValueCount || (nodes[i].m_Name != BP_BINARY_NONE && nodes[i].m_Name >= header->m_StringCount))
+            return false;
+    auto pins = reinterpret_cast<const BinaryPin*>(m_Data + header->m_PinOffset);
+    for (uint32_t i = 0; i < header->m_PinCount; i++)
+        if (pins[i].m_Value >= header->m_ValueCount || pins[i].m_Node >= header->m_NodeCount)
+            return false;
+
+    m_Header = header;
+    m_Strings = strings;
+    m_StringData = stringData;
+    m_Values = values;
+    m_Nodes = nodes;
+    m_Pins = pins;
+    m_Links = reinterpret_cast<const BinaryLink*>(m_Data + header->m_LinkOffset);
+    return true;
+}
+
+std::string BinaryDocument::String(uint32_t index) const
+{
+    if (!m_Header || index >= m_Header->m_StringCount)
+        return {};
+    return std::string(m_StringData + m_Strings[index].m_Offset, m_Strings[index].m_Length);
+}
+
+uint32_t BinaryDocument::Member(uint32_t object, const char* key) const
+{
+    if (!m_Header || object >= m_Header->m_ValueCount)
+        return BP_BINARY_NONE;
+    return FindMember(m_Values, m_Strings, m_StringData, object, key);
+}
+
+imgui_json::value BinaryDocument::Decode() const
+{
+    if (!m_Header)
+        return {};
+    return Decode(m_Header->m_Root);
+}
+
+// Validate bounds the depth, so the recursion does too
+imgui_json::value BinaryDocument::Decode(uint32_t index) const
+{
+    if (!m_Header || index >= m_Header->m_ValueCount)
+        return {};
+    auto& value = m_Values[index];
+    switch (value.m_Type)
+    {
+        case BinaryValueType::Object:
+        {
+            imgui_json::object object;
+            for (uint32_t i = 0; i < value.m_Children.m_Count; i++)
+            {
+                auto child = value.m_Children.m_First + i;
+                object.emplace_hint(object.end(), String(m_Values[child].m_Key), Decode(child));
+            }
+            return imgui_json::value(std::move(object));
+        }
+        case BinaryValueType::Array:
+        {
+            imgui_json::array array;
+            array.reserve(value.m_Children.m_Count);
+            for (uint32_t i = 0; i < value.m_Children.m_Count; i++)
+                array.push_back(Decode(value.m_Children.m_First + i));
+            return imgui_json::value(std::move(array));
+        }
+        case BinaryValueType::String:   return imgui_json::value(String(value.m_String));
+        case BinaryValueType::Boolean:  return imgui_json::value(imgui_json::boolean(value.m_Boolean != 0));
+        case BinaryValueType::Number:   return imgui_json::value(imgui_json::number(value.m_Number));
+        default:                        return {};
+    }
+}
+
+bool BinaryDocument::IsBinaryFile(const std::string& path)
+{
+    auto file = fopen(path.c_str(), "rb");
+    if (!file)
+        return false;
+    uint32_t magic = 0;
+    auto read = fread(&magic, sizeof(magic), 1, file);
+    fclose(file);
+    return read == 1 && magic == BP_BINARY_MAGIC;
+}
+
+bool BinaryDocument::Save(const imgui_json::value& value, const std::string& path)
+{
+    BinaryEncoder encoder;
+    encoder.Encode(value);
+    encoder.IndexNodes();
+
+    BinaryHeader header {};
+    header.m_Magic              = BP_BINARY_MAGIC;
+    header.m_Version            = BP_BINARY_VERSION;
+    header.m_HeaderSize         = sizeof(BinaryHeader);
+    header.m_Root               = 0;
+    header.m_StringCount        = static_cast<uint32_t>(encoder.m_Strings.size());
+    header.m_ValueCount         = static_cast<uint32_t>(encoder.m_Values.size());
+    header.m_NodeCount          = static_cast<uint32_t>(encoder.m_Nodes.size());
+    header.m_PinCount           = static_cast<uint32_t>(encoder.m_Pins.size());
+    header.m_LinkCount          = static_cast<uint32_t>(encoder.m_Links.size());
+    header.m_StringDataSize     = encoder.m_StringData.size();
+    header.m_StringOffset       = AlignUp8(sizeof(BinaryHeader));
+    header.m_StringDataOffset   = AlignUp8(header.m_StringOffset + header.m_StringCount * sizeof(BinaryString));
+    header.m_ValueOffset        = AlignUp8(header.m_StringDataOffset + header.m_StringDataSize);
+    header.m_NodeOffset         = AlignUp8(header.m_ValueOffset + header.m_ValueCount * sizeof(BinaryValue));
+    header.m_PinOffset          = AlignUp8(header.m_NodeOffset + header.m_NodeCount * sizeof(BinaryNode));
+    header.m_LinkOffset         = AlignUp8(header.m_PinOffset + header.m_PinCount * sizeof(BinaryPin));
+    header.m_FileSize           = AlignUp8(header.m_LinkOffset + header.m_LinkCount * sizeof(BinaryLink));
+
+    std::vector<uint8_t> buffer(header.m_FileSize, 0);
+    auto put = [&](uint64_t offset, const void* data, size_t size)
+    {
+        if (size)
+            memcpy(buffer.data() + offset, data, size);
+    };
+    put(0, &header, sizeof(header));
+    put(header.m_StringOffset, encoder.m_Strings.data(), encoder.m_Strings.size() * sizeof(BinaryString));
+    put(header.m_StringDataOffset, encoder.m_StringData.data(), encoder.m_StringData.size());
+    put(header.m_ValueOffset, encoder.m_Values.data(), encoder.m_Values.size() * sizeof(BinaryValue));
+    put(header.m_NodeOffset, encoder.m_Nodes.data(), encoder.m_Nodes.size() * sizeof(BinaryNode));
+    put(header.m_PinOffset, encoder.m_Pins.data(), encoder.m_Pins.size() * sizeof(BinaryPin));
+    put(header.m_LinkOffset, encoder.m_Links.data(), encoder.m_Links.size() * sizeof(BinaryLink));
+
+    auto file = fopen(path.c_str(), "wb");
+    if (!file)
+        return false;
+    auto written = fwrite(buffer.data(), 1, buffer.size(), file);
+    return fclose(file) == 0 && written == buffer.size();
+}
+
+std::pair<imgui_json::value, bool> BinaryDocument::Load(const std::string& path)
+{
+    BinaryDocument document;
+    if (!document.Open(path))
+        return {imgui_json::value(), false};
+    return {document.Decode(), true};
+}
+} // namespace BluePrint
@@ -1,8 +1,10 @@
 #include <BluePrint.h>
 #include <Node.h>
+#include <BinaryFormat.h>
 #include <imgui_helper.h>
 #include <BuildInNodes.h> // Which is generated by cmake
 #include <imgui_node_editor.h>
+#include <queue>
 
 namespace ed = ax::NodeEditor;
 
@@ -34,6 +36,51 @@ ID_TYPE IDGenerator::State() const
     return m_State;
 }
 
+// -----------------------------
+// ------[ ExecutionPlan ]------
+// -----------------------------
+void ExecutionPlan::Clear()
+{
+    m_Valid = false;
+    m_Instructions.clear();
+    m_Index.clear();
+    m_ParallelInputs.clear();
+    m_SlotCount = 0;
+}
+
+const FlowInstruction* ExecutionPlan::Find(ID_TYPE pinId) const
+{
+    if (!m_Valid)
+        return nullptr;
+
+    auto it = m_Index.find(pinId);
+    if (it == m_Index.end())
+        return nullptr;
+
+    return &m_Instructions[it->second];
+}
+
+const FlowInstruction* ExecutionPlan::Resolve(ID_TYPE pinId) const
+{
+    auto instruction = Find(pinId);
+    if (!instruction || instruction->m_Next < 0)
+        return nullptr;
+
+    return &m_Instructions[instruction->m_Next];
+}
+
+const std::vector<const Pin*>* ExecutionPlan::FindParallelInputs(const Node& node) const
+{
+    if (!m_Valid || m_ParallelInputs.empty())
+        return nullptr;
+
+    auto it = m_ParallelInputs.find(&node);
+    if (it == m_ParallelInputs.end())
+        return nullptr;
+
+    return &it->second;
+}
+
 // ---------------------------
 // ----------[ BP ]-----------
 // ---------------------------
@@ -42,21 +89,27 @@ BP::BP()
 {}
 
 BP::BP(const BP& other)
-    : m_Context(other.m_Context)
+    : m_UseArena(other.m_UseArena)
 {
     imgui_json::value value;
     other.Save(value);
     Load(value);
+    m_Context.CopySettings(other.m_Context);
 }
 
 BP::BP(BP&& other)
     : m_Generator(std::move(other.m_Generator))
+    , m_Arena(std::move(other.m_Arena))
     , m_Nodes(std::move(other.m_Nodes))
     , m_Pins(std::move(other.m_Pins))
     , m_Context(std::move(other.m_Context))
+    , m_UseArena(other.m_UseArena)
 {
     for (auto& node : m_Nodes)
         node->m_Blueprint = this;
+    m_Context.m_Plan = nullptr;
+    RebuildIndex();
+    other.RebuildIndex();
 }
 
 BP::~BP()
@@ -71,11 +124,12 @@ BP& BP::operator=(const BP& other)
 
     Clear();
 
-    m_Context = other.m_Context;
+    m_UseArena = other.m_UseArena;
 
     imgui_json::value value;
     other.Save(value);
     Load(value);
+    m_Context.CopySettings(other.m_Context);
 
     return *this;
 }
@@ -85,13 +139,24 @@ BP& BP::operator=(BP&& other)
     if (this == &other)
         return *this;
 
+    // nodes in the old arena must be gone before it is replaced
+    auto isOpen = m_IsOpen;
+    Clear();
+    m_IsOpen = isOpen;
+
     m_Generator     = std::move(other.m_Generator);
+    m_Arena         = std::move(other.m_Arena);
+    m_UseArena      = other.m_UseArena;
     m_Nodes         = std::move(other.m_Nodes);
     m_Pins          = std::move(other.m_Pins);
     m_Context       = std::move(other.m_Context);
 
     for (auto& node : m_Nodes)
         node->m_Blueprint = this;
+    m_Context.m_Plan = nullptr;
+    m_Plan.Clear();
+    RebuildIndex();
+    other.RebuildIndex();
 
     return *this;
 }
@@ -101,11 +166,14 @@ Node* BP::CreateNode(ID_TYPE nodeTypeId)
     if (!s_NodeRegistry)
         return nullptr;
 
+    ArenaScope scope(GetArena());
     auto node = s_NodeRegistry->Create(nodeTypeId, this);
     if (!node)
         return nullptr;
 
+    m_NodeIndex[node->m_ID] = m_Nodes.size();
     m_Nodes.emplace_back(node);
+    InvalidatePlan();
 
     return node;
 }
@@ -115,38 +183,50 @@ Node* BP::CreateNode(std::string nodeTypeName)
     if (!s_NodeRegistry)
         return nullptr;
 
+    ArenaScope scope(GetArena());
     auto node = s_NodeRegistry->Create(nodeTypeName, this);
     if (!node)
         return nullptr;
 
+    m_NodeIndex[node->m_ID] = m_Nodes.size();
     m_Nodes.emplace_back(node);
+    InvalidatePlan();
 
     return node;
 }
 
 void BP::DeleteNode(Node* node)
 {
-    auto nodeIt = std::find(m_Nodes.begin(), m_Nodes.end(), node);
-    if (nodeIt == m_Nodes.end())
+    if (!node)
+        return;
+
+    auto position = NodePosition(node->m_ID);
+    if (position >= m_Nodes.size() || m_Nodes[position] != node)
+        position = static_cast<size_t>(std::find(m_Nodes.begin(), m_Nodes.end(), node) - m_Nodes.begin());
+    if (position >= m_Nodes.size())
         return;
 
     if (node->m_GroupID)
     {
-        auto id = node->m_GroupID;
-        auto it = std::find_if(m_Nodes.begin(), m_Nodes.end(), [id](const Node* node)
-        {
-            return node->m_ID == id;
-        });
-        if (it != m_Nodes.end())
+        if (auto group = FindNode(node->m_GroupID))
         {
-            (*it)->OnNodeDelete(node);
+            group->OnNodeDelete(node);
         }
     }
 
-    
-    delete *nodeIt;
+    // forget the node while the pointer is still valid, a later node may get the same address
+    m_FlowOrder.erase(node);
+    m_Context.m_NodeStates.erase(node);
+    auto indexIt = m_NodeIndex.find(node->m_ID);
+    if (indexIt != m_NodeIndex.end() && indexIt->second == position)
+        m_NodeIndex.erase(indexIt);
 
-    m_Nodes.erase(nodeIt);
+    // m_Nodes is the drawing and save order, the nodes after the hole move up by one
+    m_Nodes.erase(m_Nodes.begin() + position);
+    for (auto i = position; i < m_Nodes.size(); i++)
+        m_NodeIndex[m_Nodes[i]->m_ID] = i;
+    delete node;
+    InvalidatePlan();
 }
 
 Node* BP::CloneNode(Node* node)
@@ -171,32 +251,52 @@ Node* BP::CloneNode(Node* node)
 void BP::InsertNode(Node* node)
 {
     if (node)
+    {
+        node->PinsChanged();
+        m_NodeIndex[node->m_ID] = m_Nodes.size();
         m_Nodes.emplace_back(node);
+        InvalidatePlan();
+    }
 }
 
 void BP::SwapNode(ID_TYPE src, ID_TYPE dst)
 {
-    auto iter_src = std::find_if(m_Nodes.begin(), m_Nodes.end(), [src](Node* node) {
-        return node->m_ID == src;
-    });
-    auto iter_dst = std::find_if(m_Nodes.begin(), m_Nodes.end(), [dst](Node* node) {
-        return node->m_ID == dst;
-    });
-    if (iter_src != m_Nodes.end() && iter_dst != m_Nodes.end())
-    {
-        Node * tmp = *iter_src;
-        *iter_src = *iter_dst;
-        *iter_dst = tmp;
-    }
+    auto pos_src = NodePosition(src);
+    auto pos_dst = NodePosition(dst);
+    if (pos_src >= m_Nodes.size() || pos_dst >= m_Nodes.size())
+        return;
+
+    std::swap(m_Nodes[pos_src], m_Nodes[pos_dst]);
+    m_NodeIndex[src] = pos_dst;
+    m_NodeIndex[dst] = pos_src;
 }
 
 void BP::ForgetPin(Pin* pin)
 {
-    auto pinIt = std::find(m_Pins.begin(), m_Pins.end(), pin);
-    if (pinIt == m_Pins.end())
+    // copies of registered pins (e.g. FlowPin returned by Execute) are never found here
+    auto positionIt = m_PinPositions.find(pin);
+    if (positionIt == m_PinPositions.end())
         return;
 
-    m_Pins.erase(pinIt);
+    auto position = positionIt->second;
+    m_PinPositions.erase(positionIt);
+    if (pin->m_Link)
+        OnPinUnlinked(*pin, pin->m_Link);
+    m_LinkIndex.erase(pin->m_ID);
+    auto indexIt = m_PinIndex.find(pin->m_ID);
+    if (indexIt != m_PinIndex.end() && indexIt->second == position)
+        m_PinIndex.erase(indexIt);
+
+    // order of m_Pins is not significant, move last pin into the hole
+    auto last = m_Pins.back();
+    m_Pins.pop_back();
+    if (last != pin)
+    {
+        m_Pins[position] = last;
+        m_PinPositions[last] = position;
+        m_PinIndex[last->m_ID] = position;
+    }
+    InvalidatePlan();
 }
 
 void BP::Clear()
@@ -208,8 +308,11 @@ void BP::Clear()
         //if (node->GetStyle() != NodeStyle::Group)
         //    node->OnNodeDelete(nullptr);
         node->OnClose(m_Context);
-        delete node;
     }
+    // node states hold pins pointing back at their node, they go before the nodes
+    m_Context = Context();
+    for (auto node : m_Nodes)
+        delete node;
     m_Nodes.resize(0);
 
     for (auto pin : m_Pins)
@@ -217,8 +320,212 @@ void BP::Clear()
         pin->m_Node = nullptr;
     }
     m_Pins.resize(0);
+    m_NodeIndex.clear();
+    m_PinIndex.clear();
+    m_PinPositions.clear();
+    m_IndexDirty = false;
+    m_LinkIndex.clear();
+    m_LinkIndexDirty = true;
+    m_FlowOrder.clear();
+    m_FlowOrderValid = false;
     m_Generator = IDGenerator();
-    m_Context = Context();
+    m_Plan.Clear();
+    // node and pin destructors have run, the arena goes back in one piece.
+    // Objects still alive elsewhere point at it, then the last of them frees it and the next one is fresh
+    if (m_Arena && !m_Arena->Release())
+        m_Arena.reset();
+}
+
+Arena* BP::GetArena()
+{
+    if (!m_UseArena)
+        return nullptr;
+    if (!m_Arena)
+        m_Arena.reset(new Arena());
+    return m_Arena.get();
+}
+
+void BP::Compile()
+{
+    m_Plan.Clear();
+    m_Plan.m_Generation++;
+
+    for (size_t i = 0; i < m_Pins.size(); i++)
+        m_Pins[i]->m_Slot = static_cast<int32_t>(i);
+    // nodes which swap pins without PinsChanged get their sides right before a run
+    for (auto node : m_Nodes)
+        node->PinsChanged();
+    m_Plan.m_SlotCount = static_cast<uint32_t>(m_Pins.size());
+
+    for (auto pin : m_Pins)
+    {
+        if (!pin || pin->m_Type != PinType::Flow)
+            continue;
+        auto flowPin = dynamic_cast<FlowPin*>(pin);
+        if (!flowPin)
+            continue;
+        m_Plan.m_Index[pin->m_ID] = static_cast<int32_t>(m_Plan.m_Instructions.size());
+        m_Plan.m_Instructions.push_back({flowPin});
+    }
+
+    for (auto& instruction : m_Plan.m_Instructions)
+    {
+        // same walk as Context::GetPinValue, flow ends at the last pin of the link chain
+        Pin* target = instruction.m_Pin;
+        size_t depth = 0;
+        while (target && depth++ <= m_Pins.size())
+        {
+            auto link = target->GetLink(this);
+            if (!link)
+                break;
+            target = link;
+        }
+        auto targetIt = m_Plan.m_Index.find(target->m_ID);
+        if (depth <= m_Pins.size() && targetIt != m_Plan.m_Index.end() && m_Plan.m_Instructions[targetIt->second].m_Pin == target)
+            instruction.m_Next = targetIt->second;
+
+        // same walk as Context::Step, only bridge/shadow pins are passed through
+        auto link = instruction.m_Pin->GetLink(this);
+        depth = 0;
+        while (link && link->IsMappedPin() && depth++ <= m_Pins.size())
+            link = link->GetLink(this);
+        instruction.m_HasLink = link && link->m_Type == PinType::Flow;
+    }
+
+    for (auto node : m_Nodes)
+    {
+        std::vector<const Pin*> inputs;
+        std::unordered_set<const Node*> claimed;
+        for (auto pin : node->GetInputPins())
+        {
+            if (pin->m_Type == PinType::Flow)
+                continue;
+            // the value is cached on the pin at the end of the link chain
+            Pin* provider = pin->GetLink(this);
+            size_t depth = 0;
+            while (provider && provider->GetLink(this) && depth++ <= m_Pins.size())
+                provider = provider->GetLink(this);
+            if (!provider || !provider->m_Node || provider->m_Type == PinType::Flow || provider->m_Slot < 0)
+                continue;
+            if (std::find(inputs.begin(), inputs.end(), provider) != inputs.end())
+                continue;
+
+            bool heavy = false;
+            std::unordered_set<const Node*> visited;
+            if (!CollectParallelSubtree(provider->m_Node, heavy, visited) || !heavy)
+                continue;
+            // subtrees sharing nodes are left to the serial path
+            if (std::any_of(visited.begin(), visited.end(), [&claimed](const Node* n) { return claimed.count(n) > 0; }))
+                continue;
+            claimed.insert(visited.begin(), visited.end());
+            inputs.push_back(provider);
+        }
+        if (inputs.size() > 1)
+            m_Plan.m_ParallelInputs[node] = std::move(inputs);
+    }
+
+    m_Plan.m_Valid = true;
+}
+
+bool BP::CollectParallelSubtree(Node* node, bool& heavy, std::unordered_set<const Node*>& visited) const
+{
+    if (!visited.insert(node).second)
+        return true;
+    if (!node->IsThreadSafe() || !node->IsMemoizable())
+        return false;
+    if (node->GetCost() == NodeCost::Heavy)
+        heavy = true;
+    for (auto pin : node->GetInputPins())
+    {
+        if (pin->m_Type == PinType::Flow)
+            continue;
+        auto link = pin->GetLink(this);
+        if (link && link->m_Node && !CollectParallelSubtree(link->m_Node, heavy, visited))
+            return false;
+    }
+    return true;
+}
+
+void BP::InvalidatePlan()
+{
+    m_Plan.Invalidate();
+}
+
+const ExecutionPlan& BP::GetExecutionPlan() const
+{
+    return m_Plan;
+}
+
+std::vector<Node*> BP::CollectBranchNodes(const Node& owner, const FlowPin& branch) const
+{
+    std::vector<Node*> nodes;
+    if (!m_Plan.m_Valid)
+        return nodes;
+
+    std::unordered_set<const Node*> visited;
+    std::vector<const Pin*> pending = { &branch };
+    while (!pending.empty())
+    {
+        auto pin = pending.back();
+        pending.pop_back();
+        auto instruction = m_Plan.Resolve(pin->m_ID);
+        if (!instruction || !instruction->m_Pin->m_Node)
+            continue;
+        auto node = instruction->m_Pin->m_Node;
+        if (!visited.insert(node).second || dynamic_cast<JoinNode*>(node))
+            continue;
+        nodes.push_back(node);
+        if (node == &owner)
+            continue;
+        for (auto output : node->GetOutputPins())
+        {
+            if (output->m_Type == PinType::Flow)
+                pending.push_back(output);
+        }
+    }
+    return nodes;
+}
+
+bool BP::CanRunConcurrently(const Node& owner, span<FlowPin* const> branches, span<Pin* const> inputs) const
+{
+    if (!m_Plan.m_Valid)
+        return false;
+
+    std::unordered_set<const Node*> claimed;
+    std::vector<const Pin*> data(inputs.begin(), inputs.end());
+    for (auto branch : branches)
+    {
+        for (auto node : CollectBranchNodes(owner, *branch))
+        {
+            if (node == &owner || !node->IsThreadSafe() || !claimed.insert(node).second)
+                return false;
+            for (auto input : node->GetInputPins())
+            {
+                if (input->m_Type != PinType::Flow)
+                    data.push_back(input);
+            }
+        }
+    }
+
+    // providers are evaluated on demand by every branch, flow nodes among them only hand out values they already set
+    std::unordered_set<const Node*> evaluated;
+    while (!data.empty())
+    {
+        auto pin = data.back();
+        data.pop_back();
+        auto link = pin->GetLink(this);
+        if (!link || !link->m_Node || link->m_Node == &owner || !evaluated.insert(link->m_Node).second)
+            continue;
+        auto provider = link->m_Node;
+        auto pins = provider->GetInputPins();
+        if (std::any_of(pins.begin(), pins.end(), [](const Pin* p) { return p->m_Type == PinType::Flow; }))
+            continue;
+        if (!provider->IsThreadSafe())
+            return false;
+        for (auto input : pins)
+            data.push_back(input);
+    }
+    return true;
 }
 
 span<Node*> BP::GetNodes()
@@ -252,13 +559,29 @@ Node* BP::FindNode(ID_TYPE nodeId)
 
 const Node* BP::FindNode(ID_TYPE nodeId) const
 {
-    for (auto& node : m_Nodes)
+    auto position = NodePosition(nodeId);
+    return position < m_Nodes.size() ? m_Nodes[position] : nullptr;
+}
+
+size_t BP::NodePosition(ID_TYPE nodeId) const
+{
+    auto indexIt = m_NodeIndex.find(nodeId);
+    if (indexIt != m_NodeIndex.end() && indexIt->second < m_Nodes.size() && m_Nodes[indexIt->second]->m_ID == nodeId)
+        return indexIt->second;
+    if (!m_IndexDirty)
+        return m_Nodes.size();
+
+    // index is stale while nodes are loading
+    for (size_t i = 0; i < m_Nodes.size(); i++)
     {
-        if (node->m_ID == nodeId)
-            return node;
+        if (m_Nodes[i]->m_ID == nodeId)
+        {
+            m_NodeIndex[nodeId] = i;
+            return i;
+        }
     }
 
-    return nullptr;
+    return m_Nodes.size();
 }
 
 Pin* BP::FindPin(ID_TYPE pinId)
@@ -268,10 +591,20 @@ Pin* BP::FindPin(ID_TYPE pinId)
 
 const Pin* BP::FindPin(ID_TYPE pinId) const
 {
-    for (auto& pin : m_Pins)
+    auto indexIt = m_PinIndex.find(pinId);
+    if (indexIt != m_PinIndex.end() && indexIt->second < m_Pins.size() && m_Pins[indexIt->second]->m_ID == pinId)
+        return m_Pins[indexIt->second];
+    if (!m_IndexDirty)
+        return nullptr;
+
+    // index is stale while pins are loading
+    for (size_t i = 0; i < m_Pins.size(); i++)
     {
-        if (pin->m_ID == pinId)
-            return pin;
+        if (m_Pins[i]->m_ID == pinId)
+        {
+            m_PinIndex[pinId] = i;
+            return m_Pins[i];
+        }
     }
 
     return nullptr;
@@ -372,35 +705,64 @@ StepResult BP::Stop()
 
 StepResult BP::Execute(Node& entryPointNode, bool bypass_bg_node)
 {
-    auto nodeIt = std::find(m_Nodes.begin(), m_Nodes.end(), static_cast<Node*>(&entryPointNode));
-    if (nodeIt == m_Nodes.end())
+    return Execute(m_Context, entryPointNode, bypass_bg_node);
+}
+
+StepResult BP::Run(Node& entryPointNode, bool bypass_bg_node)
+{
+    return Run(m_Context, entryPointNode, bypass_bg_node);
+}
+
+std::unique_ptr<Context> BP::CreateContext()
+{
+    if (!m_Plan.IsValid())
+        Compile();
+
+    auto context = std::make_unique<Context>();
+    context->m_Shared = true;
+    context->m_Plan = &m_Plan;
+    return context;
+}
+
+StepResult BP::Execute(Context& context, Node& entryPointNode, bool bypass_bg_node)
+{
+    if (FindNode(entryPointNode.m_ID) != &entryPointNode)
         return StepResult::Error;
 
-    if (!m_Context.m_Executing)
-        ResetState();
+    if (!context.m_Executing)
+    {
+        if (!m_Plan.IsValid())
+            Compile();
+        context.m_Plan = &m_Plan;
+        ResetState(context);
+    }
     auto entry_pin = entryPointNode.GetOutputFlowPin();
     if (!entry_pin)
         return StepResult::Error;
 #if defined(__EMSCRIPTEN__)
-    return m_Context.Start(*entry_pin);
+    return context.Start(*entry_pin);
 #else
-    return m_Context.Execute(*entry_pin, bypass_bg_node);
+    return context.Execute(*entry_pin, bypass_bg_node);
 #endif
 }
 
-StepResult BP::Run(Node& entryPointNode, bool bypass_bg_node)
+StepResult BP::Run(Context& context, Node& entryPointNode, bool bypass_bg_node)
 {
-    auto nodeIt = std::find(m_Nodes.begin(), m_Nodes.end(), static_cast<Node*>(&entryPointNode));
-    if (nodeIt == m_Nodes.end())
+    if (FindNode(entryPointNode.m_ID) != &entryPointNode)
         return StepResult::Error;
 
-    if (!m_Context.m_Executing)
-        ResetState();
+    if (!context.m_Executing)
+    {
+        if (!m_Plan.IsValid())
+            Compile();
+        context.m_Plan = &m_Plan;
+        ResetState(context);
+    }
 
     auto entry_pin = entryPointNode.GetOutputFlowPin();
     if (!entry_pin)
         return StepResult::Error;
-    return m_Context.Run(*entry_pin, bypass_bg_node);
+    return context.Run(*entry_pin, bypass_bg_node);
 }
 
 StepResult BP::Pause()
@@ -432,6 +794,28 @@ StepResult BP::StepToEnd(Node * node)
         return BluePrint::StepResult::Done;
 }
 
+void BP::MarkDirty(Node* node)
+{
+    if (node)
+        m_DirtyNodes.insert(node->m_ID);
+}
+
+StepResult BP::Rerun(Node& entryPointNode, bool bypass_bg_node)
+{
+    if (FindNode(entryPointNode.m_ID) != &entryPointNode || m_Context.m_Executing)
+        return StepResult::Error;
+
+    if (!m_Plan.IsValid())
+        Compile();
+    m_Context.m_Plan = &m_Plan;
+    ResetState(m_Context, true);
+
+    auto entry_pin = entryPointNode.GetOutputFlowPin();
+    if (!entry_pin)
+        return StepResult::Error;
+    return m_Context.Run(*entry_pin, bypass_bg_node);
+}
+
 bool BP::IsExecuting()
 {
     return m_Context.m_Executing;
@@ -503,6 +887,7 @@ Node * BP::CreateDummyNode(const imgui_json::value& value, BP* blueprint)
 {
     DummyNode * dummy = (BluePrint::DummyNode *)s_NodeRegistry->Create("DummyNode", blueprint);
     imgui_json::GetTo<imgui_json::number>(value, "id", dummy->m_ID);
+    blueprint->InvalidateIndex();
     imgui_json::GetTo<imgui_json::string>(value, "name", dummy->m_name);
     imgui_json::GetTo<imgui_json::string>(value, "type_name", dummy->m_type_name);
     string v;
@@ -517,6 +902,149 @@ Node * BP::CreateDummyNode(const imgui_json::value& value, BP* blueprint)
     return (Node *)dummy;
 }
 
+// Node creation order for an arena, providers before the nodes they feed so the arena follows the flow.
+// successors holds the link edges between node indices. Ties and cycles keep the file order.
+static std::vector<size_t> TopologicalLoadOrder(const std::vector<std::vector<size_t>>& successors)
+{
+    auto count = successors.size();
+    std::vector<size_t> inDegree(count, 0);
+    for (auto& next : successors)
+    {
+        for (auto node : next)
+            inDegree[node]++;
+    }
+
+    std::vector<size_t> order;
+    order.reserve(count);
+    std::vector<bool> placed(count, false);
+    std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>> ready;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (inDegree[i] == 0)
+            ready.push(i);
+    }
+    size_t nextUnplaced = 0;
+    while (order.size() < count)
+    {
+        if (ready.empty())
+        {
+            // a cycle, its first node in file order goes next
+            while (placed[nextUnplaced]) nextUnplaced++;
+            ready.push(nextUnplaced);
+        }
+        auto node = ready.top();
+        ready.pop();
+        if (placed[node])
+            continue;
+        placed[node] = true;
+        order.push_back(node);
+        for (auto next : successors[node])
+        {
+            if (--inDegree[next] == 0 && !placed[next])
+                ready.push(next);
+        }
+    }
+    return order;
+}
+
+// Flow links sit on output pins and data links on input pins, both point at the other node's pin
+static void AddLoadEdge(std::vector<std::vector<size_t>>& successors, size_t node, bool output, size_t linked)
+{
+    if (node == linked)
+        return;
+    if (output)
+        successors[node].push_back(linked);
+    else
+        successors[linked].push_back(node);
+}
+
+static std::vector<size_t> TopologicalLoadOrder(const imgui_json::array& nodes)
+{
+    auto count = nodes.size();
+    auto forEachPin = [&nodes](size_t node, bool output, auto&& func)
+    {
+        const imgui_json::array* pins = nullptr;
+        if (imgui_json::GetPtrTo(nodes[node], output ? "output_pins" : "input_pins", pins))
+        {
+            for (auto& pin : *pins)
+                func(pin);
+        }
+    };
+
+    std::unordered_map<ID_TYPE, size_t> pinOwner;
+    for (size_t i = 0; i < count; i++)
+    {
+        for (auto output : {false, true})
+        {
+            forEachPin(i, output, [&](const imgui_json::value& pin)
+            {
+                ID_TYPE id = 0;
+                if (imgui_json::GetTo<imgui_json::number>(pin, "id", id))
+                    pinOwner[id] = i;
+            });
+        }
+    }
+
+    std::vector<std::vector<size_t>> successors(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        for (auto output : {false, true})
+        {
+            forEachPin(i, output, [&](const imgui_json::value& pin)
+            {
+                ID_TYPE link = 0;
+                if (!imgui_json::GetTo<imgui_json::number>(pin, "link", link) || !link)
+                    return;
+                auto ownerIt = pinOwner.find(link);
+                if (ownerIt != pinOwner.end())
+                    AddLoadEdge(successors, i, output, ownerIt->second);
+            });
+        }
+    }
+    return TopologicalLoadOrder(successors);
+}
+
+// same order from the pin and link records, nothing is decoded
+static std::vector<size_t> TopologicalLoadOrder(const BinaryDocument& document)
+{
+    std::unordered_map<ID_TYPE, const BinaryPin*> pins;
+    for (uint32_t i = 0; i < document.PinCount(); i++)
+        pins[document.Pin(i).m_ID] = &document.Pin(i);
+
+    std::vector<std::vector<size_t>> successors(document.NodeCount());
+    for (uint32_t i = 0; i < document.LinkCount(); i++)
+    {
+        auto& link = document.Link(i);
+        auto receiverIt = pins.find(link.m_Receiver);
+        auto providerIt = pins.find(link.m_Provider);
+        if (receiverIt == pins.end() || providerIt == pins.end())
+            continue;
+        AddLoadEdge(successors, receiverIt->second->m_Node, receiverIt->second->m_Output != 0, providerIt->second->m_Node);
+    }
+    return TopologicalLoadOrder(successors);
+}
+
+Node * BP::LoadNode(ID_TYPE typeId, const imgui_json::value& value)
+{
+    int ret = 0;
+    auto node = s_NodeRegistry->Create(typeId, this);
+    if (!node)
+    {
+        // Create a Dummy node to replace real node
+        node = CreateDummyNode(value, this);
+        node->Load(value);
+    }
+    else if ((ret = node->Load(value)) != BP_ERR_NONE)
+    {
+        // Create a Dummy node to replace real node
+        node = CreateDummyNode(value, this);
+        node->Load(value);
+    }
+
+    node->PreLoad();
+    return node;
+}
+
 int BP::Load(const imgui_json::value& value)
 {
     if (!value.is_object())
@@ -529,30 +1057,29 @@ int BP::Load(const imgui_json::value& value)
         return BP_ERR_NODE_LOAD;
 
     //IDGenerator generator;
-    for (auto& nodeValue : *nodeArray)
+    // nodes are created in flow order into the arena, m_Nodes keeps the file order
+    ArenaScope scope(GetArena());
+    auto order = GetArena() ? TopologicalLoadOrder(*nodeArray) : std::vector<size_t>();
+    std::vector<Node*> loaded(nodeArray->size(), nullptr);
+    int result = BP_ERR_NONE;
+    for (size_t n = 0; n < loaded.size(); n++)
     {
-        int ret = 0;
+        auto index = order.empty() ? n : order[n];
+        auto& nodeValue = (*nodeArray)[index];
         ID_TYPE typeId;
         if (!imgui_json::GetTo<imgui_json::number>(nodeValue, "type_id", typeId)) // required
-            return BP_ERR_NODE_LOAD;
-
-        auto node = s_NodeRegistry->Create(typeId, this);
-        if (!node)
-        {
-            // Create a Dummy node to replace real node
-            node = CreateDummyNode(nodeValue, this);
-            node->Load(nodeValue);
-        }
-        else if ((ret = node->Load(nodeValue)) != BP_ERR_NONE)
         {
-            // Create a Dummy node to replace real node
-            node = CreateDummyNode(nodeValue, this);
-            node->Load(nodeValue);
+            result = BP_ERR_NODE_LOAD;
+            break;
         }
-
-        node->PreLoad();
-        m_Nodes.emplace_back(node);
+        loaded[index] = LoadNode(typeId, nodeValue);
     }
+    for (auto node : loaded)
+    {
+        if (node) m_Nodes.emplace_back(node);
+    }
+    if (result != BP_ERR_NONE)
+        return result;
 
     const imgui_json::object* stateObject = nullptr;
     if (!imgui_json::GetPtrTo(value, "state", stateObject)) // required
@@ -564,6 +1091,57 @@ int BP::Load(const imgui_json::value& value)
 
     m_Generator.SetState(generatorState);
     m_IsOpen = true;
+    RebuildIndex();
+    InvalidatePlan();
+    return BP_ERR_NONE;
+}
+
+int BP::Load(const BinaryDocument& document, uint32_t value)
+{
+    if (!document.IsOpen() || value >= document.Header().m_ValueCount || document.Value(value).m_Type != BinaryValueType::Object)
+        return BP_ERR_NODE_LOAD;
+
+    Clear();
+
+    // the node records must be exactly the members of this "nodes" array
+    auto nodes = document.Member(value, "nodes"); // required
+    if (nodes == BP_BINARY_NONE || document.Value(nodes).m_Type != BinaryValueType::Array)
+        return BP_ERR_NODE_LOAD;
+    auto& nodeRange = document.Value(nodes).m_Children;
+    if (document.NodeCount() != nodeRange.m_Count)
+        return BP_ERR_NODE_LOAD;
+    for (uint32_t i = 0; i < document.NodeCount(); i++)
+    {
+        auto nodeValue = document.Node(i).m_Value;
+        if (nodeValue != nodeRange.m_First + i || document.Member(nodeValue, "type_id") == BP_BINARY_NONE) // required
+            return BP_ERR_NODE_LOAD;
+    }
+
+    // each node object is decoded on its own and dropped once the node has loaded
+    ArenaScope scope(GetArena());
+    auto order = GetArena() ? TopologicalLoadOrder(document) : std::vector<size_t>();
+    std::vector<Node*> loaded(document.NodeCount(), nullptr);
+    for (size_t n = 0; n < loaded.size(); n++)
+    {
+        auto index = order.empty() ? n : order[n];
+        auto& record = document.Node(static_cast<uint32_t>(index));
+        loaded[index] = LoadNode(record.m_TypeID, document.Decode(record.m_Value));
+    }
+    for (auto node : loaded)
+        m_Nodes.emplace_back(node);
+
+    auto state = document.Member(value, "state"); // required
+    auto generator = state != BP_BINARY_NONE ? document.Member(state, "generator_state") : BP_BINARY_NONE; // required
+    if (generator == BP_BINARY_NONE || document.Value(generator).m_Type != BinaryValueType::Number)
+        return BP_ERR_NODE_LOAD;
+    auto generatorState = document.Value(generator).m_Number;
+    if (!(generatorState >= 0 && generatorState <= double(UINT32_MAX)))
+        return BP_ERR_NODE_LOAD;
+
+    m_Generator.SetState(static_cast<uint32_t>(generatorState));
+    m_IsOpen = true;
+    RebuildIndex();
+    InvalidatePlan();
     return BP_ERR_NONE;
 }
 
@@ -580,12 +1158,15 @@ int BP::Import(const imgui_json::value& value, ImVec2 pos)
     if (!imgui_json::GetTo<imgui_json::number>(groupValue, "type_id", typeId)) // required
         return BP_ERR_GROUP_LOAD;
 
+    ArenaScope scope(GetArena());
     GroupNode *group_node = (GroupNode *)s_NodeRegistry->Create(typeId, this);
     if (!group_node)
         return BP_ERR_GROUP_LOAD;
 
     group_node->LoadGroup(value, pos);
     m_Nodes.emplace_back(group_node);
+    RebuildIndex();
+    InvalidatePlan();
 
     return BP_ERR_NONE;
 }
@@ -612,6 +1193,14 @@ void BP::Save(imgui_json::value& value) const
 
 int BP::Load(std::string path)
 {
+    if (BinaryDocument::IsBinaryFile(path))
+    {
+        BinaryDocument document;
+        if (!document.Open(path))
+            return -1;
+        return Load(document, document.Root());
+    }
+
     auto value = imgui_json::value::load(path);
     if (!value.second)
         return -1;
@@ -634,75 +1223,375 @@ ID_TYPE BP::MakeNodeID(Node* node)
 
 ID_TYPE BP::MakePinID(Pin* pin)
 {
-    if (pin) m_Pins.push_back(pin);
+    auto id = m_Generator.GenerateID();
+    if (pin)
+    {
+        m_PinIndex[id] = m_Pins.size();
+        m_PinPositions[pin] = m_Pins.size();
+        m_Pins.push_back(pin);
+        InvalidatePlan();
+    }
 
-    return m_Generator.GenerateID();
+    return id;
 }
 
 Pin * BP::GetPinFromID(ID_TYPE pinid)
 {
-    if (m_Pins.empty())
-        return nullptr;
+    return FindPin(pinid);
+}
+
+const Pin * BP::GetPinFromID(ID_TYPE pinid) const
+{
+    return FindPin(pinid);
+}
 
-    auto it = std::find_if(m_Pins.begin(), m_Pins.end(), [pinid](const Pin * const pin)
+bool BP::HasPinAnyLink(const Pin& pin) const
+{
+    if (pin.IsLinked())
+        return true;
+
+    UpdateLinkIndex();
+    auto it = m_LinkIndex.find(pin.m_ID);
+    if (it == m_LinkIndex.end())
+        return false;
+    for (auto receiver : it->second)
     {
-        return pin->m_ID == pinid;
-    });
-    if (it != m_Pins.end())
+        if (m_PinPositions.count(receiver) && receiver->m_Link == pin.m_ID)
+            return true;
+    }
+    return false;
+}
+
+vector<Pin*> BP::FindPinsLinkedTo(const Pin& pin) const
+{
+    vector<Pin*> result;
+    UpdateLinkIndex();
+    auto it = m_LinkIndex.find(pin.m_ID);
+    if (it == m_LinkIndex.end())
+        return result;
+    for (auto receiver : it->second)
     {
-        return *it;
+        if (m_PinPositions.count(receiver) && receiver->m_Link == pin.m_ID)
+            result.push_back(receiver);
     }
-    return nullptr;
+    return result;
 }
 
-const Pin * BP::GetPinFromID(ID_TYPE pinid) const
+void BP::OnPinLinked(Pin& receiver, ID_TYPE provider)
 {
-    if (m_Pins.empty())
-        return nullptr;
+    if (m_LinkIndexDirty)
+        return;
+    auto& receivers = m_LinkIndex[provider];
+    if (std::find(receivers.begin(), receivers.end(), &receiver) == receivers.end())
+        receivers.push_back(&receiver);
+
+    auto providerPin = FindPin(provider);
+    if (receiver.m_Type == PinType::Flow && providerPin && receiver.m_Node != providerPin->m_Node && receiver.IsOutput())
+        InsertFlowEdge(receiver.m_Node, providerPin->m_Node);
+}
+
+void BP::OnPinUnlinked(Pin& receiver, ID_TYPE provider)
+{
+    // removing an edge keeps a topological order valid, a loop may be gone though
+    if (!m_FlowOrderValid)
+        m_LinkIndexDirty = true;
+    if (m_LinkIndexDirty)
+        return;
+    auto it = m_LinkIndex.find(provider);
+    if (it == m_LinkIndex.end())
+        return;
+    auto& receivers = it->second;
+    receivers.erase(std::remove(receivers.begin(), receivers.end(), &receiver), receivers.end());
+    if (receivers.empty())
+        m_LinkIndex.erase(it);
+}
 
-    auto it = std::find_if(m_Pins.begin(), m_Pins.end(), [pinid](const Pin * const pin)
+void BP::UpdateLinkIndex() const
+{
+    if (!m_LinkIndexDirty)
+        return;
+    m_LinkIndex.clear();
+    for (auto pin : m_Pins)
     {
-        return pin->m_ID == pinid;
-    });
-    if (it != m_Pins.end())
+        if (pin->m_Link)
+            m_LinkIndex[pin->m_Link].push_back(pin);
+    }
+    m_LinkIndexDirty = false;
+    UpdateFlowOrder();
+}
+
+// Flow edges run from the node of an output flow pin to the node its link points to, same as the
+// old AcceptLink walk. Links between pins of one node (group bridge/shadow pins) are not edges.
+void BP::FlowSuccessors(const Node* node, std::vector<const Node*>& result) const
+{
+    for (auto pin : const_cast<Node*>(node)->GetOutputPins())
     {
-        return *it;
+        if (pin->GetType() != PinType::Flow)
+            continue;
+        auto link = pin->GetLink(this);
+        if (link && link->m_Node && link->m_Node != node)
+            result.push_back(link->m_Node);
     }
-    return nullptr;
 }
 
-bool BP::HasPinAnyLink(const Pin& pin) const
+void BP::FlowPredecessors(const Node* node, std::vector<const Node*>& result) const
 {
-    if (pin.IsLinked())
-        return true;
+    auto collect = [&](span<Pin*> pins)
+    {
+        for (auto pin : pins)
+        {
+            if (pin->GetType() != PinType::Flow)
+                continue;
+            for (auto receiver : FindPinsLinkedTo(*pin))
+            {
+                if (receiver->m_Node && receiver->m_Node != node && receiver->IsOutput())
+                    result.push_back(receiver->m_Node);
+            }
+        }
+    };
+    collect(const_cast<Node*>(node)->GetInputPins());
+    collect(const_cast<Node*>(node)->GetOutputPins());
+}
 
-    if (pin.m_LinkFrom.size() > 0)
-        return true;
+void BP::UpdateFlowOrder() const
+{
+    // Kahn's algorithm over the whole graph, only after loads and other bulk changes
+    m_FlowOrder.clear();
+    std::unordered_map<const Node*, size_t> inDegree;
+    std::vector<const Node*> successors;
+    for (auto node : m_Nodes)
+    {
+        inDegree.emplace(node, 0);
+        successors.clear();
+        FlowSuccessors(node, successors);
+        for (auto next : successors)
+            inDegree[next]++;
+    }
 
-    return false;
+    std::vector<const Node*> ready;
+    for (auto node : m_Nodes)
+    {
+        if (inDegree[node] == 0)
+            ready.push_back(node);
+    }
+    int64_t order = 0;
+    while (!ready.empty())
+    {
+        auto node = ready.back();
+        ready.pop_back();
+        m_FlowOrder[node] = order++;
+        successors.clear();
+        FlowSuccessors(node, successors);
+        for (auto next : successors)
+        {
+            if (--inDegree[next] == 0)
+                ready.push_back(next);
+        }
+    }
+    m_NextFlowOrder = order;
+    m_FlowOrderValid = m_FlowOrder.size() == inDegree.size();
 }
 
-vector<Pin*> BP::FindPinsLinkedTo(const Pin& pin) const
+int64_t BP::FlowOrderOf(const Node* node) const
 {
-    vector<Pin*> result;
-    for (auto& p : m_Pins)
+    // nodes created since the last rebuild have no edges yet, any place fits them
+    auto it = m_FlowOrder.find(node);
+    if (it != m_FlowOrder.end())
+        return it->second;
+    return m_FlowOrder[node] = m_NextFlowOrder++;
+}
+
+void BP::InsertFlowEdge(const Node* from, const Node* to)
+{
+    if (!m_FlowOrderValid)
+        return;
+    auto lower = FlowOrderOf(to);
+    auto upper = FlowOrderOf(from);
+    if (upper < lower)
+        return;
+
+    // Pearce-Kelly, only nodes ordered between to and from can be out of place
+    std::vector<const Node*> forward, backward, pending, adjacent;
+    std::unordered_set<const Node*> visited;
+    pending.push_back(to);
+    visited.insert(to);
+    while (!pending.empty())
     {
-        auto linkedPin = p->GetLink(this);
-        if(std::find(m_Pins.begin(), m_Pins.end(), linkedPin) != m_Pins.end())
+        auto node = pending.back();
+        pending.pop_back();
+        forward.push_back(node);
+        adjacent.clear();
+        FlowSuccessors(node, adjacent);
+        for (auto next : adjacent)
         {
-            if (linkedPin && linkedPin->m_ID == pin.m_ID)
-                result.push_back(p);
+            if (next == from)
+            {
+                m_FlowOrderValid = false;   // flow loop, possible when links are made around AcceptLink
+                return;
+            }
+            if (FlowOrderOf(next) < upper && visited.insert(next).second)
+                pending.push_back(next);
         }
     }
-    return result;
+
+    pending.push_back(from);
+    visited.insert(from);
+    while (!pending.empty())
+    {
+        auto node = pending.back();
+        pending.pop_back();
+        backward.push_back(node);
+        adjacent.clear();
+        FlowPredecessors(node, adjacent);
+        for (auto prev : adjacent)
+        {
+            if (FlowOrderOf(prev) > lower && visited.insert(prev).second)
+                pending.push_back(prev);
+        }
+    }
+
+    // backward part takes the lowest of the freed places, in its old relative order
+    auto byOrder = [this](const Node* a, const Node* b) { return m_FlowOrder[a] < m_FlowOrder[b]; };
+    std::sort(forward.begin(), forward.end(), byOrder);
+    std::sort(backward.begin(), backward.end(), byOrder);
+    std::vector<int64_t> places;
+    places.reserve(forward.size() + backward.size());
+    for (auto node : backward)
+        places.push_back(m_FlowOrder[node]);
+    for (auto node : forward)
+        places.push_back(m_FlowOrder[node]);
+    std::sort(places.begin(), places.end());
+    size_t i = 0;
+    for (auto node : backward)
+        m_FlowOrder[node] = places[i++];
+    for (auto node : forward)
+        m_FlowOrder[node] = places[i++];
+}
+
+bool BP::FlowReaches(const Node& from, const Node& to) const
+{
+    UpdateLinkIndex();
+    int64_t upper = 0;
+    if (m_FlowOrderValid)
+    {
+        // a path only ever goes to higher places, and without a loop never back to its start
+        if (&from == &to)
+            return false;
+        upper = FlowOrderOf(&to);
+        if (upper < FlowOrderOf(&from))
+            return false;
+    }
+
+    // every node is entered once, nodes placed after the target are never entered
+    std::vector<const Node*> pending {&from}, adjacent;
+    std::unordered_set<const Node*> visited {&from};
+    while (!pending.empty())
+    {
+        auto node = pending.back();
+        pending.pop_back();
+        adjacent.clear();
+        FlowSuccessors(node, adjacent);
+        for (auto next : adjacent)
+        {
+            if (next == &to)
+                return true;
+            if ((!m_FlowOrderValid || FlowOrderOf(next) < upper) && visited.insert(next).second)
+                pending.push_back(next);
+        }
+    }
+    return false;
+}
+
+void BP::RebuildIndex()
+{
+    m_NodeIndex.clear();
+    m_PinIndex.clear();
+    m_PinPositions.clear();
+    m_IndexDirty = false;
+    m_NodeIndex.reserve(m_Nodes.size());
+    m_PinIndex.reserve(m_Pins.size());
+    m_PinPositions.reserve(m_Pins.size());
+    for (size_t i = 0; i < m_Nodes.size(); i++)
+        m_NodeIndex[m_Nodes[i]->m_ID] = i;
+    for (size_t i = 0; i < m_Pins.size(); i++)
+    {
+        m_PinIndex[m_Pins[i]->m_ID] = i;
+        m_PinPositions[m_Pins[i]] = i;
+    }
+    m_LinkIndexDirty = true;
 }
 
 void BP::ResetState()
 {
-    m_Context.ResetState();
+    ResetState(m_Context);
+}
+
+void BP::ResetState(Context& context)
+{
+    context.ResetState();
+    if (&context == &m_Context)
+        m_DirtyNodes.clear();
 
     for (auto node : m_Nodes)
-        node->Reset(m_Context);
+        node->Reset(context);
+}
+
+void BP::ResetState(Context& context, bool incremental)
+{
+    if (!incremental || !context.ResetState(CollectDirtyNodes()))
+    {
+        ResetState(context);
+        return;
+    }
+    if (&context == &m_Context)
+        m_DirtyNodes.clear();
+
+    for (auto node : m_Nodes)
+    {
+        if (context.CanReplay(*node))
+        {
+            context.GetNodeState(*node).m_Hits = 0;
+            continue;
+        }
+        for (auto pin : node->GetInputPins())
+            context.DropPinValue(*pin);
+        for (auto pin : node->GetOutputPins())
+            context.DropPinValue(*pin);
+        node->Reset(context);
+    }
+}
+
+std::unordered_set<const Node*> BP::CollectDirtyNodes() const
+{
+    // data consumers of every node, flow links carry no values so they do not spread changes
+    std::unordered_map<const Node*, std::vector<const Node*>> consumers;
+    std::vector<const Node*> pending;
+    for (auto node : m_Nodes)
+    {
+        for (auto pin : node->GetInputPins())
+        {
+            if (pin->m_Type == PinType::Flow)
+                continue;
+            auto link = pin->GetLink(this);
+            if (link && link->m_Node && link->m_Node != node)
+                consumers[link->m_Node].push_back(node);
+        }
+        if (!node->IsReusable() || m_DirtyNodes.count(node->m_ID))
+            pending.push_back(node);
+    }
+
+    std::unordered_set<const Node*> dirtyNodes;
+    while (!pending.empty())
+    {
+        auto node = pending.back();
+        pending.pop_back();
+        if (!dirtyNodes.insert(node).second)
+            continue;
+        auto consumerIt = consumers.find(node);
+        if (consumerIt != consumers.end())
+            pending.insert(pending.end(), consumerIt->second.begin(), consumerIt->second.end());
+    }
+    return dirtyNodes;
 }
 # pragma endregion
 
@@ -16,6 +16,7 @@ struct DummyNode final : Node
     {
         Pin* pin = new Pin(this, type, name);
         m_InputPins.push_back(pin);
+        PinsChanged();
         return pin;
     }
 
@@ -23,6 +24,7 @@ struct DummyNode final : Node
     {
         Pin* pin = new Pin(this, type, name);
         m_OutputPins.push_back(pin);
+        PinsChanged();
         return pin;
     }
 
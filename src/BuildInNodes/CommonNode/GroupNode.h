@@ -50,10 +50,9 @@ struct GroupNode final : Node
     {
         if (pin.m_Type == PinType::Flow)
         {
-            for (auto from_pin : pin.m_LinkFrom)
+            for (auto link : m_Blueprint->FindPinsLinkedTo(pin))
             {
-                auto link = m_Blueprint->GetPinFromID(from_pin);
-                if (link && PinIsBridgeOut(*link) && link->m_Node == this)
+                if (PinIsBridgeOut(*link) && link->m_Node == this)
                 {
                     return true;
                 }
@@ -119,6 +118,7 @@ struct GroupNode final : Node
             (*bridge_pin)->m_MappedPin = pin->m_ID;
             (*bridge_pin)->m_Flags = PIN_FLAG_BRIDGE | PIN_FLAG_IN;
             m_InputBridgePins.push_back(*bridge_pin);
+            PinsChanged();
         }
         else
         {
@@ -179,6 +179,7 @@ struct GroupNode final : Node
         {
             bridge_pin = *it;
             m_InputBridgePins.erase(it);
+            PinsChanged();
         }
         // Try to Remove Shadow Pin
         it = std::find_if(m_InputShadowPins.begin(), m_InputShadowPins.end(), [pid](Pin * const pin)
@@ -198,10 +199,9 @@ struct GroupNode final : Node
             // Try to rebuild input link
             if (pin->m_Type == PinType::Flow)
             {
-                auto link_from = bridge_pin->m_LinkFrom; // Unlink will change m_LinkFrom, so we clone it
-                for (auto from_pin : link_from)
+                auto link_from = m_Blueprint->FindPinsLinkedTo(*bridge_pin); // a copy, Unlink changes the link index
+                for (auto link : link_from)
                 {
-                    auto link = m_Blueprint->GetPinFromID(from_pin);
                     if (link)
                     {
                         link->Unlink();
@@ -259,6 +259,7 @@ struct GroupNode final : Node
             (*bridge_pin)->m_MappedPin = pin->m_ID;
             (*bridge_pin)->m_Flags = PIN_FLAG_BRIDGE | PIN_FLAG_OUT;
             m_OutputBridgePins.push_back(*bridge_pin);
+            PinsChanged();
         }
         else
         {
@@ -317,6 +318,7 @@ struct GroupNode final : Node
         {
             bridge_pin = *it;
             m_OutputBridgePins.erase(it);
+            PinsChanged();
         }
         // Try to Remove Shadow Pin
         it = std::find_if(m_OutputShadowPins.begin(), m_OutputShadowPins.end(), [pid](Pin * const pin)
@@ -346,10 +348,9 @@ struct GroupNode final : Node
             }
             else
             {
-                auto link_from = bridge_pin->m_LinkFrom; // relink will change m_LinkFrom, so we clone it
-                for (auto from_pin : link_from)
+                auto link_from = m_Blueprint->FindPinsLinkedTo(*bridge_pin); // a copy, relink changes the link index
+                for (auto link : link_from)
                 {
-                    auto link = m_Blueprint->GetPinFromID(from_pin);
                     if (link)
                     {
                         link->LinkTo(*pin);
@@ -387,10 +388,9 @@ struct GroupNode final : Node
                 {
                     bool export_pin = false;
                     // Check extra link first
-                    auto link_from = pin->m_LinkFrom; // clone link vector
-                    for (auto from_pin : link_from)
+                    auto link_from = m_Blueprint->FindPinsLinkedTo(*pin); // a copy, links change below
+                    for (auto link : link_from)
                     {
-                        auto link = m_Blueprint->GetPinFromID(from_pin);
                         if (link)
                         {
                             auto linked_node = link->m_Node;
@@ -418,6 +418,7 @@ struct GroupNode final : Node
                                 if (it_b != m_OutputBridgePins.end())
                                 {
                                     m_OutputBridgePins.erase(it_b);
+                                    PinsChanged();
                                     link->Unlink();
                                     delete link;
                                 }
@@ -562,6 +563,7 @@ struct GroupNode final : Node
                                 if (it_b != m_OutputBridgePins.end())
                                 {
                                     m_OutputBridgePins.erase(it_b);
+                                    PinsChanged();
                                     link->Unlink();
                                     delete link;
                                 }
@@ -709,6 +711,7 @@ struct GroupNode final : Node
                                 if (it_b != m_InputBridgePins.end())
                                 {
                                     m_InputBridgePins.erase(it_b);
+                                    PinsChanged();
                                     link->Unlink();
                                     delete link;
                                 }
@@ -826,10 +829,9 @@ struct GroupNode final : Node
                 {
                     bool export_pin = false;
                     // Check extra link first
-                    auto link_from = pin->m_LinkFrom; // clone link vector
-                    for (auto from_pin : link_from)
+                    auto link_from = m_Blueprint->FindPinsLinkedTo(*pin); // a copy, links change below
+                    for (auto link : link_from)
                     {
-                        auto link = m_Blueprint->GetPinFromID(from_pin);
                         if (link)
                         {
                             auto linked_node = link->m_Node;
@@ -857,6 +859,7 @@ struct GroupNode final : Node
                                 if (it_b != m_InputBridgePins.end())
                                 {
                                     m_InputBridgePins.erase(it_b);
+                                    PinsChanged();
                                     link->Unlink();
                                     delete link;
                                 }
@@ -1145,6 +1148,7 @@ struct GroupNode final : Node
             }
             if (pin) pinArray.push_back(pin);
         }
+        PinsChanged();
         return BP_ERR_NONE;
     }
 
@@ -1156,6 +1160,7 @@ struct GroupNode final : Node
 
         if (!imgui_json::GetTo<imgui_json::number>(value, "id", m_ID)) // required
             return BP_ERR_NODE_LOAD;
+        if (m_Blueprint) m_Blueprint->InvalidateIndex();
 
         if (!imgui_json::GetTo<imgui_json::string>(value, "name", m_Name)) // required
             return BP_ERR_NODE_LOAD;
@@ -1328,6 +1333,7 @@ struct GroupNode final : Node
 
     inline void AdjestPinID(Pin * pin, std::map<ID_TYPE, ID_TYPE>& IDMaps)
     {
+        if (m_Blueprint) m_Blueprint->InvalidateIndex();
         pin->m_ID = GetIDFromMap(pin->m_ID, IDMaps);
         if (pin->m_MappedPin) pin->m_MappedPin = GetIDFromMap(pin->m_MappedPin, IDMaps);
         if (pin->m_Link) pin->m_Link = GetIDFromMap(pin->m_Link, IDMaps);
@@ -1416,6 +1422,7 @@ struct GroupNode final : Node
         Load(groupValue);
         auto GroupStatus = statusValue[edd::Serialization::ToString((const ed::NodeId)(m_ID))];
         m_ID = GetIDFromMap(m_ID, IDMaps);
+        m_Blueprint->InvalidateIndex();
         for (auto pin : m_InputBridgePins)
         {
             AdjestPinID(pin, IDMaps);
@@ -4,7 +4,7 @@ namespace BluePrint
 {
 struct FilterEntryPointNode final : Node
 {
-    BP_NODE(FilterEntryPointNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::EntryPoint, NodeStyle::Simple, "System")
+    BP_NODE(FilterEntryPointNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::EntryPoint, NodeStyle::Simple, "System", NODE_FLAG_THREAD_SAFE | NODE_FLAG_DETERMINISTIC, NodeCost::Trivial)
 
     FilterEntryPointNode(BP* blueprint): Node(blueprint) {
         m_Name = "Start"; 
@@ -22,6 +22,7 @@ struct FilterEntryPointNode final : Node
         Pin* pin = new Pin(this, type, name);
         pin->m_Flags |= PIN_FLAG_FORCESHOW;
         m_OutputPins.push_back(pin);
+        PinsChanged();
         return pin;
     }
 
@@ -46,6 +47,7 @@ struct FilterEntryPointNode final : Node
                 }
             }
             m_OutputPins.erase(iter);
+            PinsChanged();
         }
     }
 
@@ -106,7 +108,7 @@ struct FilterEntryPointNode final : Node
                         return BP_ERR_GENERAL;
                     }
                 }
-                if (pin) pinArray.push_back(pin);
+                if (pin) { pinArray.push_back(pin); PinsChanged(); }
             }
         }
         return BP_ERR_NONE;
@@ -120,6 +122,7 @@ struct FilterEntryPointNode final : Node
 
         if (!imgui_json::GetTo<imgui_json::number>(value, "id", m_ID)) // required
             return BP_ERR_NODE_LOAD;
+        if (m_Blueprint) m_Blueprint->InvalidateIndex();
 
         if (!imgui_json::GetTo<imgui_json::string>(value, "name", m_Name)) // required
             return BP_ERR_NODE_LOAD;
@@ -4,7 +4,7 @@ namespace BluePrint
 {
 struct TransitionEntryPointNode final : Node
 {
-    BP_NODE(TransitionEntryPointNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::EntryPoint, NodeStyle::Simple, "System")
+    BP_NODE(TransitionEntryPointNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::EntryPoint, NodeStyle::Simple, "System", NODE_FLAG_THREAD_SAFE | NODE_FLAG_DETERMINISTIC, NodeCost::Trivial)
 
     TransitionEntryPointNode(BP* blueprint): Node(blueprint) 
     {
@@ -25,6 +25,7 @@ struct TransitionEntryPointNode final : Node
         Pin* pin = new Pin(this, type, name);
         pin->m_Flags |= PIN_FLAG_FORCESHOW;
         m_OutputPins.push_back(pin);
+        PinsChanged();
         return pin;
     }
 
@@ -49,6 +50,7 @@ struct TransitionEntryPointNode final : Node
                 }
             }
             m_OutputPins.erase(iter);
+            PinsChanged();
         }
     }
 
@@ -109,7 +111,7 @@ struct TransitionEntryPointNode final : Node
                         return BP_ERR_GENERAL;
                     }
                 }
-                if (pin) pinArray.push_back(pin);
+                if (pin) { pinArray.push_back(pin); PinsChanged(); }
             }
         }
         return BP_ERR_NONE;
@@ -123,6 +125,7 @@ struct TransitionEntryPointNode final : Node
 
         if (!imgui_json::GetTo<imgui_json::number>(value, "id", m_ID)) // required
             return BP_ERR_NODE_LOAD;
+        if (m_Blueprint) m_Blueprint->InvalidateIndex();
 
         if (!imgui_json::GetTo<imgui_json::string>(value, "name", m_Name)) // required
             return BP_ERR_NODE_LOAD;
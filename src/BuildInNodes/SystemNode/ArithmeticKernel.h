@@ -0,0 +1,153 @@
+#pragma once
+#include <imgui.h>
+#include <MatKernel.h>
+namespace BluePrint
+{
+// Typed kernels for the two operand nodes (Add/Sub/Mul/Div/Compare).
+// SetType picks one function per type, so EvaluatePin does not switch on the node type.
+// ImMat goes element-wise through MatKernel, Array element-wise on its numbers.
+using BinaryKernel = PinValue (*)(const PinValue& a, const PinValue& b);
+
+template <typename T> struct PinTypeOf;
+template <> struct PinTypeOf<bool>          { static constexpr auto Type = PinType::Bool; };
+template <> struct PinTypeOf<int32_t>       { static constexpr auto Type = PinType::Int32; };
+template <> struct PinTypeOf<int64_t>       { static constexpr auto Type = PinType::Int64; };
+template <> struct PinTypeOf<float>         { static constexpr auto Type = PinType::Float; };
+template <> struct PinTypeOf<double>        { static constexpr auto Type = PinType::Double; };
+template <> struct PinTypeOf<std::string>   { static constexpr auto Type = PinType::String; };
+
+template <typename T, typename Op>
+inline PinValue BinaryKernelOf(const PinValue& a, const PinValue& b)
+{
+    if (a.GetType() != PinTypeOf<T>::Type || b.GetType() != PinTypeOf<T>::Type)
+        return {}; // Error: Node values must be of same type
+    return Op()(a.As<T>(), b.As<T>());
+}
+
+// nullptr when Op has no kernel for type
+template <typename Op, typename... Types>
+inline BinaryKernel SelectBinaryKernel(PinType type)
+{
+    BinaryKernel kernel = nullptr;
+    ((type == PinTypeOf<Types>::Type ? (void)(kernel = &BinaryKernelOf<Types, Op>) : (void)0), ...);
+    return kernel;
+}
+
+// Whole matrices are worth evaluating in parallel, element-wise arrays less so, scalars never
+inline NodeCost KernelCost(PinType type)
+{
+    switch (type)
+    {
+        case PinType::Mat:   return NodeCost::Heavy;
+        case PinType::Array: return NodeCost::Light;
+        default:             return NodeCost::Trivial;
+    }
+}
+
+// ImMat and Array operands may take a scalar as B, it applies to every element
+inline bool IsBroadcastScalar(PinType type)
+{
+    return type == PinType::Int32 || type == PinType::Int64 || type == PinType::Float || type == PinType::Double;
+}
+
+// B already linked to a scalar stays linked when the node turns Mat or Array, SetType leaves its type alone
+inline bool KeepsBroadcastScalar(const Pin& b, PinType type)
+{
+    auto provider = b.GetLink();
+    return (type == PinType::Mat || type == PinType::Array) && provider && IsBroadcastScalar(provider->GetValueType());
+}
+
+inline bool ScalarOf(const PinValue& value, double& scalar)
+{
+    switch (value.GetType())
+    {
+        case PinType::Int32:  scalar = value.As<int32_t>(); return true;
+        case PinType::Int64:  scalar = static_cast<double>(value.As<int64_t>()); return true;
+        case PinType::Float:  scalar = value.As<float>(); return true;
+        case PinType::Double: scalar = value.As<double>(); return true;
+        default:              return false;
+    }
+}
+
+template <MatOp Op>
+inline PinValue MatKernelOf(const PinValue& a, const PinValue& b)
+{
+    if (a.GetType() != PinType::Mat)
+        return {};
+    ImGui::ImMat result;
+    double scalar = 0.0;
+    if (b.GetType() == PinType::Mat)
+        result = MatBinary(Op, a.As<ImGui::ImMat>(), b.As<ImGui::ImMat>());
+    else if (ScalarOf(b, scalar))
+        result = MatBinary(Op, a.As<ImGui::ImMat>(), scalar);
+    if (result.empty())
+        return {}; // Error: Mats of different layout, type or device
+    return result;
+}
+
+inline PinValue MatCompareKernel(const PinValue& a, const PinValue& b)
+{
+    int32_t result = 0;
+    if (a.GetType() != PinType::Mat || b.GetType() != PinType::Mat || !MatCompare(a.As<ImGui::ImMat>(), b.As<ImGui::ImMat>(), result))
+        return {};
+    return result;
+}
+
+// Arrays of numbers, element by element or with a scalar B
+template <typename Op>
+inline PinValue ArrayKernelOf(const PinValue& a, const PinValue& b)
+{
+    if (a.GetType() != PinType::Array)
+        return {};
+    auto& x = a.As<imgui_json::array>();
+    double scalar = 0.0;
+    bool broadcast = ScalarOf(b, scalar);
+    if (!broadcast && (b.GetType() != PinType::Array || b.As<imgui_json::array>().size() != x.size()))
+        return {}; // Error: Arrays must have the same length
+    imgui_json::array result;
+    result.reserve(x.size());
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        auto y = scalar;
+        if (!broadcast)
+        {
+            auto& item = b.As<imgui_json::array>()[i];
+            if (!item.is_number())
+                return {}; // Error: Only arrays of numbers
+            y = item.get<imgui_json::number>();
+        }
+        if (!x[i].is_number())
+            return {}; // Error: Only arrays of numbers
+        result.push_back(imgui_json::number(Op()(x[i].get<imgui_json::number>(), y)));
+    }
+    return result;
+}
+
+// Arrays compare element by element like strings, the shorter one is less on a common prefix
+template <typename Op>
+inline PinValue ArrayCompareKernel(const PinValue& a, const PinValue& b)
+{
+    if (a.GetType() != PinType::Array || b.GetType() != PinType::Array)
+        return {};
+    auto& x = a.As<imgui_json::array>();
+    auto& y = b.As<imgui_json::array>();
+    for (size_t i = 0; i < x.size() && i < y.size(); i++)
+    {
+        if (!x[i].is_number() || !y[i].is_number())
+            return {}; // Error: Only arrays of numbers
+        if (auto result = Op()(x[i].get<imgui_json::number>(), y[i].get<imgui_json::number>()))
+            return result;
+    }
+    return x.size() == y.size() ? 0 : (x.size() < y.size() ? -1 : 1);
+}
+
+template <typename Op, MatOp MatOperation, typename... Types>
+inline BinaryKernel SelectElementKernel(PinType type)
+{
+    if (type == PinType::Mat)
+        return &MatKernelOf<MatOperation>;
+    if (type == PinType::Array)
+        return &ArrayKernelOf<Op>;
+    return SelectBinaryKernel<Op, Types...>(type);
+}
+} // namespace BluePrint
@@ -1,5 +1,6 @@
 #pragma once
 #include <imgui.h>
+#include "ArithmeticKernel.h"
 #if IMGUI_ICONS
 #define ICON_CMP_SYMBOL "\u2268"
 #else
@@ -9,64 +10,29 @@ namespace BluePrint
 {
 struct CompareNode final : Node
 {
-    BP_NODE(CompareNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Simple, "Arithmetic")
+    BP_NODE(CompareNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Simple, "Arithmetic", NODE_FLAG_PURE | NODE_FLAG_THREAD_SAFE | NODE_FLAG_DETERMINISTIC, NodeCost::Trivial)
     CompareNode(BP* blueprint): Node(blueprint) { SetType(PinType::Any); }
 
+    struct Op
+    {
+        template <typename T> int32_t operator()(const T& a, const T& b) const { return a > b ? 1 : (a < b ? -1 : 0); }
+        int32_t operator()(const std::string& a, const std::string& b) const { return a.compare(b); }
+    };
+
     PinValue EvaluatePin(const Context& context, const Pin& pin, bool threading = false) const override
     {
         if (pin.m_ID == m_Result.m_ID)
         {
-            auto aValue = context.GetPinValue(m_A);
-            auto bValue = context.GetPinValue(m_B);
-
-            if (aValue.GetType() != m_Type ||
-                bValue.GetType() != m_Type)
-            {
-                return {}; // Error: Node values must be of same type
-            }
-
-            switch (m_Type)
-            {
-                case PinType::Int32:
-                    if (aValue.As<int32_t>() > bValue.As<int32_t>())
-                        return 1;
-                    else if (aValue.As<int32_t>() < bValue.As<int32_t>())
-                        return -1;
-                    else
-                        return 0;
-                case PinType::Int64:
-                    if (aValue.As<int64_t>() > bValue.As<int64_t>())
-                        return 1;
-                    else if (aValue.As<int64_t>() < bValue.As<int64_t>())
-                        return -1;
-                    else
-                        return 0;
-                case PinType::Float:
-                    if (aValue.As<float>() > bValue.As<float>())
-                        return 1;
-                    else if (aValue.As<float>() < bValue.As<float>())
-                        return -1;
-                    else
-                        return 0;
-                case PinType::Double:
-                    if (aValue.As<double>() > bValue.As<double>())
-                        return 1;
-                    else if (aValue.As<double>() < bValue.As<double>())
-                        return -1;
-                    else
-                        return 0;
-                case PinType::String:
-                    return aValue.As<string>().compare(bValue.As<string>());
-                default:
-                    break;
-            }
-
-            return {}; // Error: Unsupported type
+            if (!m_Kernel)
+                return {}; // Error: Unsupported type
+            return m_Kernel(context.GetPinValue(m_A), context.GetPinValue(m_B));
         }
         else
             return Node::EvaluatePin(context, pin);
     }
 
+    NodeCost GetCost() const override { return KernelCost(m_Type); }
+
     std::string GetName() const override
     {
         return m_Name;
@@ -101,6 +67,8 @@ struct CompareNode final : Node
                 case PinType::Float:
                 case PinType::Double:
                 case PinType::String:
+                case PinType::Mat:
+                case PinType::Array:
                     return { true, "Other pins will convert to this pin type" };
 
                 default:
@@ -162,6 +130,12 @@ struct CompareNode final : Node
         m_A.SetValueType(type);
         m_B.SetValueType(type);
 
+        if (type == PinType::Mat)
+            m_Kernel = &MatCompareKernel;
+        else if (type == PinType::Array)
+            m_Kernel = &ArrayCompareKernel<Op>;
+        else
+            m_Kernel = SelectBinaryKernel<Op, int32_t, int64_t, float, double, std::string>(type);
         m_Type = type;
     }
 
@@ -181,6 +155,7 @@ struct CompareNode final : Node
 
 private:
     PinType m_PendingType = PinType::Any;
+    BinaryKernel m_Kernel {nullptr};
 
 };
 } // namespace BluePrint
@@ -5,7 +5,7 @@ namespace BluePrint
 {
 struct ConstValueNode final : Node
 {
-    BP_NODE(ConstValueNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Default, "Flow")
+    BP_NODE(ConstValueNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Default, "Flow", NODE_FLAG_PURE | NODE_FLAG_THREAD_SAFE | NODE_FLAG_DETERMINISTIC, NodeCost::Trivial)
 
     ConstValueNode(BP* blueprint): Node(blueprint) 
     {
@@ -6,7 +6,7 @@ namespace BluePrint
 {
 struct CountNode final : Node
 {
-    BP_NODE(CountNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Default, "Flow")
+    BP_NODE(CountNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Default, "Flow", NODE_FLAG_THREAD_SAFE | NODE_FLAG_DETERMINISTIC, NodeCost::Trivial)
 
     CountNode(BP* blueprint): Node(blueprint) { m_Name = "Count"; }
 
@@ -32,6 +32,22 @@ struct CountNode final : Node
             return m_Completed;
         }
 
+        if (!m_Accumulate && context.CanRunInline())
+        {
+            auto next = [&]()
+            {
+                auto counter = context.GetPinValue<int32_t>(m_Counter);
+                if (counter >= context.GetPinValue<int32_t>(m_N))
+                    return false;
+                context.SetPinValue(m_Counter, counter + 1);
+                return true;
+            };
+            if (!context.RunInlineLoop(entryPoint, m_Exit, next, threading))
+                return {};
+            Reset(context);
+            return m_Completed;
+        }
+
         context.SetPinValue(m_Counter, c + 1);
 
         if (!m_Accumulate)
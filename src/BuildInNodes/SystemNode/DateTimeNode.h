@@ -22,14 +22,21 @@ struct DateTimeNode final : Node
         DATETIME_ZONE       = 1 << 12,
     };
     BP_NODE(DateTimeNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Default, "Flow")
+    struct DateTimeState : NodeState
+    {
+        int64_t m_start_time = 0;
+    };
+
     DateTimeNode(BP* blueprint): Node(blueprint) { m_Name = "Date Time"; }
 
+    NodeState* CreateState() const override { return new DateTimeState(); }
+
     void Reset(Context& context) override
     {
         Node::Reset(context);
         context.SetPinValue(m_count, 0);
         context.SetPinValue(m_count_float, 0);
-        m_start_time = ImGui::get_current_time_usec();
+        context.GetNodeState<DateTimeState>(*this).m_start_time = ImGui::get_current_time_usec();
     }
 
     FlowPin Execute(Context& context, FlowPin& entryPoint, bool threading = false) override
@@ -53,7 +60,7 @@ struct DateTimeNode final : Node
         context.SetPinValue(m_uSec, (int32_t)usec);
         context.SetPinValue(m_TimeStamp, hi_time);
 
-        auto count_time = hi_time - m_start_time;
+        auto count_time = hi_time - context.GetNodeState<DateTimeState>(*this).m_start_time;
         context.SetPinValue(m_count, (int32_t)count_time);
         context.SetPinValue(m_count_float, (float)count_time / 1000000.f);
 #ifdef _WIN32
@@ -161,6 +168,7 @@ struct DateTimeNode final : Node
         if (m_out_flags & DATETIME_ZONE)        { m_OutputPins.push_back(&m_Zone); }
         if (m_out_flags & DATETIME_COUNT)       { m_OutputPins.push_back(&m_count); }
         if (m_out_flags & DATETIME_COUNT_FLOAT) { m_OutputPins.push_back(&m_count_float); }
+        PinsChanged();
     }
 
     span<Pin*> GetInputPins() override { return m_InputPins; }
@@ -195,6 +203,5 @@ struct DateTimeNode final : Node
     std::vector<Pin *> m_OutputPins;
 
     int32_t m_out_flags = 0;
-    int64_t m_start_time = 0;
 };
 } // namespace BluePrint
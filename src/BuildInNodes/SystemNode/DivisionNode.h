@@ -1,5 +1,7 @@
 #pragma once
 #include <imgui.h>
+#include "ArithmeticKernel.h"
+#include <limits>
 #if IMGUI_ICONS
 #define ICON_DIV_SYMBOL "\u29BC"
 #else
@@ -9,48 +11,34 @@ namespace BluePrint
 {
 struct DivNode final : Node
 {
-    BP_NODE(DivNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Simple, "Arithmetic")
+    BP_NODE(DivNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Simple, "Arithmetic", NODE_FLAG_PURE | NODE_FLAG_THREAD_SAFE | NODE_FLAG_DETERMINISTIC, NodeCost::Trivial)
 
     DivNode(BP* blueprint): Node(blueprint)
     {
         SetType(PinType::Any);
     }
 
+    struct Op
+    {
+        template <typename T> T operator()(const T& a, const T& b) const { return b == 0 ? std::numeric_limits<T>::max() : a / b; }
+        float operator()(float a, float b) const { return a / (b + 1e-10f); }
+        double operator()(double a, double b) const { return a / (b + 1e-10f); }
+    };
+
     PinValue EvaluatePin(const Context& context, const Pin& pin, bool threading = false) const override
     {
         if (pin.m_ID == m_Result.m_ID)
         {
-            auto aValue = context.GetPinValue(m_A);
-            auto bValue = context.GetPinValue(m_B);
-
-            if (aValue.GetType() != m_Type ||
-                bValue.GetType() != m_Type)
-            {
-                return {}; // Error: Node values must be of same type
-            }
-
-            switch (m_Type)
-            {
-                case PinType::Int32:
-                    if (bValue.As<int32_t>() == 0) return INT_MAX;
-                    return aValue.As<int32_t>() / bValue.As<int32_t>();
-                case PinType::Int64:
-                    if (bValue.As<int64_t>() == 0) return (int64_t)LLONG_MAX;
-                    return aValue.As<int64_t>() / bValue.As<int64_t>();
-                case PinType::Float:
-                    return aValue.As<float>() / (bValue.As<float>() + 1e-10f);
-                case PinType::Double:
-                    return aValue.As<double>() / (bValue.As<double>() + 1e-10f);
-                default:
-                    break;
-            }
-
-            return {}; // Error: Unsupported type
+            if (!m_Kernel)
+                return {}; // Error: Unsupported type
+            return m_Kernel(context.GetPinValue(m_A), context.GetPinValue(m_B));
         }
         else
             return Node::EvaluatePin(context, pin);
     }
 
+    NodeCost GetCost() const override { return KernelCost(m_Type); }
+
     std::string GetName() const override
     {
         return m_Name;
@@ -84,6 +72,8 @@ struct DivNode final : Node
                 case PinType::Int64:
                 case PinType::Float:
                 case PinType::Double:
+                case PinType::Mat:
+                case PinType::Array:
                     return { true, "Other pins will convert to this pin type" };
 
                 default:
@@ -99,6 +89,9 @@ struct DivNode final : Node
         if (m_Type == PinType::Void)
             return;
 
+        if (receiver.m_ID == m_B.m_ID && (m_Type == PinType::Mat || m_Type == PinType::Array) && IsBroadcastScalar(provider.GetValueType()))
+            return; // scalar B applies to every element, the node keeps its type
+
         if (receiver.m_ID == m_A.m_ID || receiver.m_ID == m_B.m_ID)
             SetType(provider.GetValueType());
         else if (provider.m_ID == m_Result.m_ID)
@@ -145,9 +138,11 @@ struct DivNode final : Node
         m_PendingType = type;
 
         m_A.SetValueType(type);
-        m_B.SetValueType(type);
+        if (!KeepsBroadcastScalar(m_B, type))
+            m_B.SetValueType(type);
         m_Result.SetValueType(type);
 
+        m_Kernel = SelectElementKernel<Op, MatOp::Div, int32_t, int64_t, float, double>(type);
         m_Type = type;
     }
 
@@ -167,5 +162,6 @@ struct DivNode final : Node
 
 private:
     PinType m_PendingType = PinType::Any;
+    BinaryKernel m_Kernel {nullptr};
 };
 } // namespace BluePrint
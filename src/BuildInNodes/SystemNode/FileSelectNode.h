@@ -234,6 +234,7 @@ struct FileSelectNode final : Node
         if (m_out_flags & FILESELECT_FOLDER)    { m_OutputPins.push_back(&m_FilePath); }
         if (m_out_flags & FILESELECT_NAME)      { m_OutputPins.push_back(&m_FileName); }
         if (m_out_flags & FILESELECT_SUFFIX)    { m_OutputPins.push_back(&m_FileSuffix); }
+        PinsChanged();
     }
 
     span<Pin*> GetInputPins() override { return m_InputPins; }
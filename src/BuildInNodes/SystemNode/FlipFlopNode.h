@@ -5,7 +5,7 @@ namespace BluePrint
 {
 struct FlipFlopNode final : Node
 {
-    BP_NODE(FlipFlopNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Default, "Flow")
+    BP_NODE(FlipFlopNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Default, "Flow", NODE_FLAG_THREAD_SAFE | NODE_FLAG_DETERMINISTIC, NodeCost::Trivial)
 
     FlipFlopNode(BP* blueprint): Node(blueprint) { m_Name = "Flip Flop"; }
 
@@ -6,7 +6,7 @@ namespace BluePrint
 {
 struct FloatCountNode final : Node
 {
-    BP_NODE(FloatCountNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Default, "Flow")
+    BP_NODE(FloatCountNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Default, "Flow", NODE_FLAG_THREAD_SAFE | NODE_FLAG_DETERMINISTIC, NodeCost::Trivial)
 
     FloatCountNode(BP* blueprint): Node(blueprint) { m_Name = "Float Count"; }
 
@@ -33,6 +33,22 @@ struct FloatCountNode final : Node
             return m_Completed;
         }
 
+        if (!m_Accumulate && context.CanRunInline())
+        {
+            auto next = [&]()
+            {
+                auto counter = context.GetPinValue<float>(m_Counter);
+                if (counter >= context.GetPinValue<float>(m_N))
+                    return false;
+                context.SetPinValue(m_Counter, counter + context.GetPinValue<float>(m_Step));
+                return true;
+            };
+            if (!context.RunInlineLoop(entryPoint, m_Exit, next, threading))
+                return {};
+            Reset(context);
+            return m_Completed;
+        }
+
         context.SetPinValue(m_Counter, c + s);
 
         if (!m_Accumulate)
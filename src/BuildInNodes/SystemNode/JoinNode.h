@@ -0,0 +1,34 @@
+#pragma once
+#include <imgui.h>
+
+namespace BluePrint
+{
+struct JoinNode final : Node
+{
+    BP_NODE(JoinNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Default, "Flow", NODE_FLAG_THREAD_SAFE | NODE_FLAG_DETERMINISTIC, NodeCost::Trivial)
+
+    JoinNode(BP* blueprint): Node(blueprint) { m_Name = "Join"; }
+
+    FlowPin Execute(Context& context, FlowPin& entryPoint, bool threading = false) override
+    {
+        // a branch of ParallelNode ends here, the parent goes on from m_Exit once all branches arrived
+        if (context.m_Parent)
+        {
+            context.m_JoinNode = this;
+            return {};
+        }
+        return m_Exit;
+    }
+
+    span<Pin*> GetInputPins() override { return m_InputPins; }
+    span<Pin*> GetOutputPins() override { return m_OutputPins; }
+    Pin* GetAutoLinkInputFlowPin() override { return &m_Enter; }
+    Pin* GetAutoLinkOutputFlowPin() override { return &m_Exit; }
+
+    FlowPin m_Enter = { this, "Enter" };
+    FlowPin m_Exit  = { this, "Exit" };
+
+    Pin* m_InputPins[1] = { &m_Enter };
+    Pin* m_OutputPins[1] = { &m_Exit };
+};
+} // namespace BluePrint
@@ -4,16 +4,23 @@ namespace BluePrint
 {
 struct LoopNode final : Node
 {
-    BP_NODE(LoopNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Default, "Flow")
+    BP_NODE(LoopNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Default, "Flow", NODE_FLAG_THREAD_SAFE | NODE_FLAG_DETERMINISTIC, NodeCost::Trivial)
+
+    struct LoopState : NodeState
+    {
+        int32_t m_current_index {0};
+    };
 
     LoopNode(BP* blueprint): Node(blueprint) { m_Name = "Loop"; }
 
+    NodeState* CreateState() const override { return new LoopState(); }
+
     void Reset(Context& context) override
     {
         Node::Reset(context);
         auto firstIndex = context.GetPinValue<int32_t>(m_FirstIndex);
         context.SetPinValue(m_Index, firstIndex);
-        m_current_index = firstIndex;
+        context.GetNodeState<LoopState>(*this).m_current_index = firstIndex;
     }
     
     FlowPin Execute(Context& context, FlowPin& entryPoint, bool threading = false) override
@@ -27,10 +34,24 @@ struct LoopNode final : Node
         //auto index      = context.GetPinValue<int32_t>(m_Index);
         auto lastIndex  = context.GetPinValue<int32_t>(m_LastIndex);
         auto step       = context.GetPinValue<int32_t>(m_Step);
-        if (m_current_index <= lastIndex)
+        auto& state     = context.GetNodeState<LoopState>(*this);
+        if (state.m_current_index <= lastIndex && context.CanRunInline())
         {
-            context.SetPinValue(m_Index, m_current_index);
-            m_current_index += step;
+            auto next = [&]()
+            {
+                if (state.m_current_index > context.GetPinValue<int32_t>(m_LastIndex))
+                    return false;
+                context.SetPinValue(m_Index, state.m_current_index);
+                state.m_current_index += context.GetPinValue<int32_t>(m_Step);
+                return true;
+            };
+            if (!context.RunInlineLoop(entryPoint, m_LoopBody, next, threading))
+                return {};
+        }
+        else if (state.m_current_index <= lastIndex)
+        {
+            context.SetPinValue(m_Index, state.m_current_index);
+            state.m_current_index += step;
             context.PushReturnPoint(entryPoint);
             std::this_thread::yield();
             return m_LoopBody;
@@ -57,7 +78,5 @@ struct LoopNode final : Node
 
     Pin* m_InputPins[5] = { &m_Enter, &m_FirstIndex, &m_LastIndex, &m_Step, &m_Reset };
     Pin* m_OutputPins[3] = { &m_LoopBody, &m_Index, &m_Completed };
-
-    int32_t m_current_index {0};
 };
 } // namespace BluePrint
@@ -0,0 +1,285 @@
+#pragma once
+#include <imgui.h>
+#include <Executor.h>
+namespace BluePrint
+{
+struct ParallelForNode final : Node
+{
+    enum REDUCE_TYPE : int32_t
+    {
+        REDUCE_TYPE_SUM     = 0,
+        REDUCE_TYPE_MIN     = 1,
+        REDUCE_TYPE_MAX     = 2,
+        REDUCE_TYPE_COLLECT = 3,
+    };
+    BP_NODE(ParallelForNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Default, "Flow", NODE_FLAG_THREAD_SAFE)
+
+    struct ParallelForState : NodeState
+    {
+        uint32_t    m_Generation {0};   // plan generation m_Concurrent was checked for
+        bool        m_Concurrent {false};
+        std::vector<Node*> m_BodyNodes; // reset in every chunk context before it runs
+    };
+
+    ParallelForNode(BP* blueprint): Node(blueprint)
+    {
+        m_Name = "Parallel For";
+        SetType(PinType::Any);
+    }
+
+    NodeState* CreateState() const override { return new ParallelForState(); }
+
+    FlowPin Execute(Context& context, FlowPin& entryPoint, bool threading = false) override
+    {
+        // iterate the elements of a linked array, otherwise the index range
+        imgui_json::array elements;
+        bool overArray = m_Array.GetLink(m_Blueprint) != nullptr;
+        auto from = context.GetPinValue<int32_t>(m_FirstIndex);
+        auto step = context.GetPinValue<int32_t>(m_Step);
+        if (step <= 0 && !overArray)
+        {
+            LOGE("ParallelForNode: Step must be positive, got %d", step);
+            return {}; // Error: the index range would never end
+        }
+        size_t count = 0;
+        if (overArray)
+        {
+            auto value = context.GetPinValue(m_Array);
+            if (value.GetType() == PinType::Array)
+                elements = value.As<imgui_json::array>();
+            count = elements.size();
+        }
+        else
+        {
+            auto to = context.GetPinValue<int32_t>(m_LastIndex);
+            if (to >= from)
+                count = static_cast<size_t>((static_cast<int64_t>(to) - from) / step + 1);
+        }
+
+        auto& state = context.GetNodeState<ParallelForState>(*this);
+        auto generation = context.m_Plan ? context.m_Plan->m_Generation : 0;
+        if (generation == 0 || state.m_Generation != generation)
+        {
+            FlowPin* body[1] = { &m_LoopBody };
+            Pin* value[1] = { &m_Value };
+            state.m_Concurrent = generation != 0 && m_Blueprint->CanRunConcurrently(*this, body, value);
+            state.m_Generation = generation;
+            state.m_BodyNodes = m_Blueprint->CollectBranchNodes(*this, m_LoopBody);
+        }
+
+        auto& executor = context.m_Executor ? *context.m_Executor : Executor::GetDefault();
+        size_t chunks = 1;
+        if (state.m_Concurrent)
+            chunks = std::max<size_t>(std::min(count, executor.GetWorkerCount() * 4), 1);
+
+        // one child context per chunk, iterations of a chunk run one after another in it.
+        // Body nodes start reset in every chunk like in a run of their own (e.g. LoopNode at FirstIndex)
+        std::vector<std::unique_ptr<Context>> children;
+        for (size_t i = 0; i < chunks; i++)
+        {
+            children.push_back(context.Fork());
+            for (auto node : state.m_BodyNodes)
+            {
+                if (node != this)
+                    node->Reset(*children.back());
+            }
+        }
+
+        bool hasBody = m_LoopBody.GetLink(m_Blueprint) != nullptr;
+        std::vector<PinValue> results(count);
+        std::atomic<bool> failed {false};
+        auto runChunk = [&](size_t chunk)
+        {
+            auto& child = *children[chunk];
+            auto end = count * (chunk + 1) / chunks;
+            for (size_t i = count * chunk / chunks; i < end && !failed; i++)
+            {
+                child.SetPinValue(m_Index, overArray ? static_cast<int32_t>(i) : static_cast<int32_t>(from + static_cast<int64_t>(i) * step));
+                if (overArray)
+                    child.SetPinValue(m_Element, FromJson(elements[i]));
+                if (hasBody && child.Run(m_LoopBody, child.m_bypass_bg_node) == StepResult::Error)
+                {
+                    failed = true;
+                    break;
+                }
+                results[i] = child.GetPinValue(m_Value);
+            }
+        };
+
+        if (chunks > 1)
+        {
+            std::vector<std::shared_future<void>> tasks;
+            for (size_t i = 1; i < chunks; i++)
+                tasks.push_back(executor.Submit([&runChunk, i]() { runChunk(i); }, true));
+            runChunk(0);
+            for (auto& task : tasks)
+                executor.Wait(task);
+        }
+        else
+            runChunk(0);
+
+        for (auto& child : children)
+            context.Merge(*child);
+        if (failed)
+            return {};
+
+        // reduced in index order so the result does not depend on scheduling
+        if (m_reduce_type == REDUCE_TYPE_COLLECT)
+        {
+            // one item per index, so items line up with the range
+            imgui_json::array items;
+            for (auto& result : results)
+            {
+                imgui_json::value item;     // stays null where the result has no json form
+                ToJson(result, item);
+                items.push_back(item);
+            }
+            context.SetPinValue(m_Items, std::move(items));
+        }
+        else
+        {
+            double reduced = 0.0;
+            bool first = true;
+            for (auto& result : results)
+            {
+                double number = 0.0;
+                if (!ToDouble(result, number))
+                    continue;
+                if (first)
+                    reduced = number;
+                else if (m_reduce_type == REDUCE_TYPE_SUM)
+                    reduced += number;
+                else if (m_reduce_type == REDUCE_TYPE_MIN)
+                    reduced = std::min(reduced, number);
+                else
+                    reduced = std::max(reduced, number);
+                first = false;
+            }
+            context.SetPinValue(m_Result, reduced);
+        }
+        return m_Completed;
+    }
+
+    static PinValue FromJson(const imgui_json::value& value)
+    {
+        if (value.is_number())  return value.get<imgui_json::number>();
+        if (value.is_string())  return value.get<imgui_json::string>();
+        if (value.is_boolean()) return value.get<imgui_json::boolean>();
+        return {};
+    }
+
+    static bool ToJson(const PinValue& value, imgui_json::value& json)
+    {
+        switch (value.GetType())
+        {
+            case PinType::Bool:   json = imgui_json::boolean(value.As<bool>()); return true;
+            case PinType::Int32:  json = imgui_json::number(value.As<int32_t>()); return true;
+            case PinType::Int64:  json = imgui_json::number(value.As<int64_t>()); return true;
+            case PinType::Float:  json = imgui_json::number(value.As<float>()); return true;
+            case PinType::Double: json = imgui_json::number(value.As<double>()); return true;
+            case PinType::String: json = imgui_json::string(value.As<string>()); return true;
+            default:              return false;
+        }
+    }
+
+    static bool ToDouble(const PinValue& value, double& number)
+    {
+        switch (value.GetType())
+        {
+            case PinType::Bool:   number = value.As<bool>() ? 1.0 : 0.0; return true;
+            case PinType::Int32:  number = value.As<int32_t>(); return true;
+            case PinType::Int64:  number = static_cast<double>(value.As<int64_t>()); return true;
+            case PinType::Float:  number = value.As<float>(); return true;
+            case PinType::Double: number = value.As<double>(); return true;
+            default:              return false;
+        }
+    }
+
+    bool DrawSettingLayout(ImGuiContext * ctx) override
+    {
+        // Draw Set Node Name
+        auto changed = Node::DrawSettingLayout(ctx);
+        ImGui::Separator();
+
+        // Draw Custom Setting
+        ImGui::SetCurrentContext(ctx);
+        changed |= ImGui::RadioButton("Sum", &m_reduce_type, REDUCE_TYPE_SUM); ImGui::SameLine();
+        changed |= ImGui::RadioButton("Min", &m_reduce_type, REDUCE_TYPE_MIN); ImGui::SameLine();
+        changed |= ImGui::RadioButton("Max", &m_reduce_type, REDUCE_TYPE_MAX); ImGui::SameLine();
+        changed |= ImGui::RadioButton("Collect", &m_reduce_type, REDUCE_TYPE_COLLECT);
+        return changed;
+    }
+
+    void SetType(PinType type)
+    {
+        m_Value.SetValueType(type);
+    }
+
+    void WasLinked(const Pin& receiver, const Pin& provider) override
+    {
+        if (receiver.m_ID == m_Value.m_ID)
+            SetType(provider.GetValueType());
+    }
+
+    void WasUnlinked(const Pin& receiver, const Pin& provider) override
+    {
+        if (receiver.m_ID == m_Value.m_ID)
+            SetType(PinType::Any);
+    }
+
+    int Load(const imgui_json::value& value) override
+    {
+        int ret = BP_ERR_NONE;
+        if ((ret = Node::Load(value)) != BP_ERR_NONE)
+            return ret;
+
+        if (value.contains("datatype"))
+        {
+            auto& typeValue = value["datatype"];
+            PinType type;
+            if (!typeValue.is_string() || !PinTypeFromString(typeValue.get<imgui_json::string>().c_str(), type))
+                return BP_ERR_NODE_LOAD;
+            SetType(type);
+        }
+
+        if (value.contains("reducetype"))
+        {
+            auto& reduceType = value["reducetype"];
+            if (reduceType.is_number())
+                m_reduce_type = reduceType.get<imgui_json::number>();
+        }
+        return ret;
+    }
+
+    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) override
+    {
+        Node::Save(value, MapID);
+        value["datatype"]   = PinTypeToString(m_Value.GetValueType());
+        value["reducetype"] = imgui_json::number(m_reduce_type);
+    }
+
+    span<Pin*> GetInputPins() override { return m_InputPins; }
+    span<Pin*> GetOutputPins() override { return m_OutputPins; }
+    Pin* GetAutoLinkInputFlowPin() override { return &m_Enter; }
+    Pin* GetAutoLinkOutputFlowPin() override { return &m_Completed; }
+    vector<Pin*> GetAutoLinkInputDataPin() override { return {&m_FirstIndex, &m_LastIndex, &m_Step}; }
+    vector<Pin*> GetAutoLinkOutputDataPin() override { return {&m_Index}; }
+
+    FlowPin   m_Enter      = { this, "Enter" };
+    Int32Pin  m_FirstIndex = { this, "From" };
+    Int32Pin  m_LastIndex  = { this, "To" };
+    Int32Pin  m_Step       = { this, "Step", 1 };
+    ArrayPin  m_Array      = { this, "Array" };
+    AnyPin    m_Value      = { this, "Value" };
+    FlowPin   m_LoopBody   = { this, "Loop Body" };
+    Int32Pin  m_Index      = { this, "Index" };
+    AnyPin    m_Element    = { this, "Element" };
+    FlowPin   m_Completed  = { this, "Completed" };
+    DoublePin m_Result     = { this, "Result" };
+    ArrayPin  m_Items      = { this, "Items" };
+
+    Pin* m_InputPins[6] = { &m_Enter, &m_FirstIndex, &m_LastIndex, &m_Step, &m_Array, &m_Value };
+    Pin* m_OutputPins[6] = { &m_LoopBody, &m_Index, &m_Element, &m_Completed, &m_Result, &m_Items };
+    int  m_reduce_type {REDUCE_TYPE_SUM};
+};
+} // namespace BluePrint
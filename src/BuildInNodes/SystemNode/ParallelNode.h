@@ -0,0 +1,115 @@
+#pragma once
+#include <imgui.h>
+#include <Executor.h>
+#include "JoinNode.h"
+
+namespace BluePrint
+{
+struct ParallelNode final : Node
+{
+    BP_NODE(ParallelNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Default, "Flow", NODE_FLAG_THREAD_SAFE)
+
+    struct ParallelState : NodeState
+    {
+        uint32_t    m_Generation {0};   // plan generation m_Concurrent was checked for
+        bool        m_Concurrent {false};
+        std::vector<std::vector<Node*>> m_BranchNodes;  // reset in every branch context before it runs
+    };
+
+    ParallelNode(BP* blueprint): Node(blueprint) { m_Name = "Parallel"; }
+
+    NodeState* CreateState() const override { return new ParallelState(); }
+
+    FlowPin Execute(Context& context, FlowPin& entryPoint, bool threading = false) override
+    {
+        std::vector<FlowPin*> branches;
+        for (auto branch : m_Branches)
+        {
+            if (branch->GetLink(m_Blueprint))
+                branches.push_back(branch);
+        }
+        if (branches.empty())
+            return m_Completed;
+
+        auto& state = context.GetNodeState<ParallelState>(*this);
+        auto generation = context.m_Plan ? context.m_Plan->m_Generation : 0;
+        if (generation == 0 || state.m_Generation != generation)
+        {
+            // providers the branches evaluate are checked too, they run on the branch threads
+            state.m_Concurrent = generation != 0 && m_Blueprint->CanRunConcurrently(*this, branches);
+            state.m_Generation = generation;
+            state.m_BranchNodes.clear();
+            for (auto branch : branches)
+                state.m_BranchNodes.push_back(m_Blueprint->CollectBranchNodes(*this, *branch));
+        }
+
+        // every branch runs in its own context, started from the values we have now and
+        // with fresh node states, reset like a run resets them (e.g. LoopNode at FirstIndex)
+        std::vector<std::unique_ptr<Context>> children;
+        for (size_t i = 0; i < branches.size(); i++)
+        {
+            children.push_back(context.Fork());
+            if (i < state.m_BranchNodes.size())
+            {
+                for (auto node : state.m_BranchNodes[i])
+                {
+                    if (node != this)
+                        node->Reset(*children.back());
+                }
+            }
+        }
+
+        if (state.m_Concurrent && branches.size() > 1)
+        {
+            auto& executor = context.m_Executor ? *context.m_Executor : Executor::GetDefault();
+            std::vector<std::shared_future<void>> tasks;
+            for (size_t i = 1; i < branches.size(); i++)
+            {
+                tasks.push_back(executor.Submit([&children, &branches, i]()
+                {
+                    children[i]->Run(*branches[i], children[i]->m_bypass_bg_node);
+                }, true));
+            }
+            children[0]->Run(*branches[0], children[0]->m_bypass_bg_node);
+            for (auto& task : tasks)
+                executor.Wait(task);
+        }
+        else
+        {
+            for (size_t i = 0; i < branches.size(); i++)
+                children[i]->Run(*branches[i], children[i]->m_bypass_bg_node);
+        }
+
+        // barrier passed, values are taken in branch order so later branches win on conflicts
+        JoinNode* join = nullptr;
+        bool joined = true;
+        for (auto& child : children)
+        {
+            context.Merge(*child);
+            auto childJoin = static_cast<JoinNode*>(child->m_JoinNode);
+            if (!childJoin || (join && join != childJoin))
+                joined = false;
+            join = childJoin;
+        }
+        if (joined && join)
+            return join->m_Exit;
+        return m_Completed;
+    }
+
+    span<Pin*> GetInputPins() override { return m_InputPins; }
+    span<Pin*> GetOutputPins() override { return m_OutputPins; }
+    Pin* GetAutoLinkInputFlowPin() override { return &m_Enter; }
+    Pin* GetAutoLinkOutputFlowPin() override { return &m_Completed; }
+
+    FlowPin m_Enter     = { this, "Enter" };
+    FlowPin m_BranchA   = { this, "A" };
+    FlowPin m_BranchB   = { this, "B" };
+    FlowPin m_BranchC   = { this, "C" };
+    FlowPin m_BranchD   = { this, "D" };
+    FlowPin m_Completed = { this, "Completed" };
+
+    FlowPin* m_Branches[4] = { &m_BranchA, &m_BranchB, &m_BranchC, &m_BranchD };
+    Pin* m_InputPins[1] = { &m_Enter };
+    Pin* m_OutputPins[5] = { &m_BranchA, &m_BranchB, &m_BranchC, &m_BranchD, &m_Completed };
+};
+} // namespace BluePrint
@@ -1,5 +1,6 @@
 #pragma once
 #include <imgui.h>
+#include "ArithmeticKernel.h"
 #if IMGUI_ICONS
 #define ICON_SUB_SYMBOL "\u2296"
 #else
@@ -9,46 +10,32 @@ namespace BluePrint
 {
 struct SubNode final : Node
 {
-    BP_NODE(SubNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Simple, "Arithmetic")
+    BP_NODE(SubNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Simple, "Arithmetic", NODE_FLAG_PURE | NODE_FLAG_THREAD_SAFE | NODE_FLAG_DETERMINISTIC, NodeCost::Trivial)
 
     SubNode(BP* blueprint): Node(blueprint)
     {
         SetType(PinType::Any);
     }
 
+    struct Op
+    {
+        template <typename T> T operator()(const T& a, const T& b) const { return a - b; }
+    };
+
     PinValue EvaluatePin(const Context& context, const Pin& pin, bool threading = false) const override
     {
         if (pin.m_ID == m_Result.m_ID)
         {
-            auto aValue = context.GetPinValue(m_A);
-            auto bValue = context.GetPinValue(m_B);
-
-            if (aValue.GetType() != m_Type ||
-                bValue.GetType() != m_Type)
-            {
-                return {}; // Error: Node values must be of same type
-            }
-
-            switch (m_Type)
-            {
-                case PinType::Int32:
-                    return aValue.As<int32_t>() - bValue.As<int32_t>();
-                case PinType::Int64:
-                    return aValue.As<int64_t>() - bValue.As<int64_t>();
-                case PinType::Float:
-                    return aValue.As<float>() - bValue.As<float>();
-                case PinType::Double:
-                    return aValue.As<double>() - bValue.As<double>();
-                default:
-                    break;
-            }
-
-            return {}; // Error: Unsupported type
+            if (!m_Kernel)
+                return {}; // Error: Unsupported type
+            return m_Kernel(context.GetPinValue(m_A), context.GetPinValue(m_B));
         }
         else
             return Node::EvaluatePin(context, pin);
     }
 
+    NodeCost GetCost() const override { return KernelCost(m_Type); }
+
     std::string GetName() const override
     {
         return m_Name;
@@ -82,6 +69,8 @@ struct SubNode final : Node
                 case PinType::Int64:
                 case PinType::Float:
                 case PinType::Double:
+                case PinType::Mat:
+                case PinType::Array:
                     return { true, "Other pins will convert to this pin type" };
 
                 default:
@@ -97,6 +86,9 @@ struct SubNode final : Node
         if (m_Type == PinType::Void)
             return;
 
+        if (receiver.m_ID == m_B.m_ID && (m_Type == PinType::Mat || m_Type == PinType::Array) && IsBroadcastScalar(provider.GetValueType()))
+            return; // scalar B applies to every element, the node keeps its type
+
         if (receiver.m_ID == m_A.m_ID || receiver.m_ID == m_B.m_ID)
             SetType(provider.GetValueType());
         else if (provider.m_ID == m_Result.m_ID)
@@ -143,9 +135,11 @@ struct SubNode final : Node
         m_PendingType = type;
 
         m_A.SetValueType(type);
-        m_B.SetValueType(type);
+        if (!KeepsBroadcastScalar(m_B, type))
+            m_B.SetValueType(type);
         m_Result.SetValueType(type);
 
+        m_Kernel = SelectElementKernel<Op, MatOp::Sub, int32_t, int64_t, float, double>(type);
         m_Type = type;
     }
 
@@ -165,5 +159,6 @@ struct SubNode final : Node
 
 private:
     PinType m_PendingType = PinType::Any;
+    BinaryKernel m_Kernel {nullptr};
 };
 } // namespace BluePrint
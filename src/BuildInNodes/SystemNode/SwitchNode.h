@@ -9,7 +9,7 @@ namespace BluePrint
 {
 struct SwitchNode final : Node
 {
-    BP_NODE(SwitchNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Simple, "Arithmetic")
+    BP_NODE(SwitchNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Simple, "Arithmetic", NODE_FLAG_PURE | NODE_FLAG_THREAD_SAFE | NODE_FLAG_DETERMINISTIC, NodeCost::Trivial)
 
     SwitchNode(BP* blueprint) : Node(blueprint) { SetType(PinType::Any); }
 
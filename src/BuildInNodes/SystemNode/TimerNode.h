@@ -4,66 +4,64 @@ namespace BluePrint
 {
 struct TimerNode final : Node
 {
-    BP_NODE(TimerNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Default, "Flow")
+    BP_NODE(TimerNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Default, "Flow", NODE_FLAG_THREAD_SAFE)
+    struct TimerState : NodeState
+    {
+        using Clock = std::chrono::steady_clock;
+        uint32_t            m_current_step  {0};
+        Clock::time_point   m_deadline      {};     // next event, default while the timer is not started
+    };
+
     TimerNode(BP* blueprint): Node(blueprint) { m_Name = "Timer"; }
+
+    NodeState* CreateState() const override { return new TimerState(); }
     
     void Reset(Context& context) override
     {
         Node::Reset(context);
-        m_current_step = 0;
-        m_current_ms = 0;
+        auto& state = context.GetNodeState<TimerState>(*this);
+        state.m_current_step = 0;
+        state.m_deadline = {};
     }
 
     FlowPin Execute(Context& context, FlowPin& entryPoint, bool threading = false) override
     {
+        using Clock = TimerState::Clock;
+        auto& state = context.GetNodeState<TimerState>(*this);
         if (entryPoint.m_ID == m_Reset.m_ID)
         {
-            m_current_step = 0;
-            m_current_ms = 0;
+            state.m_current_step = 0;
+            state.m_deadline = {};
             return {};
         }
 
-        if (m_current_ms > 0)
+        auto now_time = Clock::now();
+        auto interval = std::chrono::milliseconds(m_interval_ms);
+        if (state.m_deadline == Clock::time_point{})
         {
-            uint64_t now_time = ImGui::get_current_time_msec();
-            uint64_t delta_time = now_time - m_current_ms;
-            if (delta_time >= m_interval_ms)
-            {
-                if (m_count < 0)
-                {
-                    m_current_ms = now_time - (delta_time - m_interval_ms);
-                    context.PushReturnPoint(entryPoint);
-                    return m_TimeOut;
-                }
-                else if (m_count > 0 && m_current_step < m_count)
-                {
-                    m_current_step ++;
-                    m_current_ms = now_time - (delta_time - m_interval_ms);
-                    context.PushReturnPoint(entryPoint);
-                    return m_TimeOut;
-                }
-                else
-                {
-                    m_current_step = 0;
-                    m_current_ms = 0;
-                    return m_Exit;
-                }
-            }
-            else
-            {
-                if (threading)
-                    ImGui::sleep((int)(m_interval_ms - delta_time));
-                else
-                    ImGui::sleep(0);
-            }
+            state.m_deadline = now_time + interval;
         }
-        else
+        else if (now_time >= state.m_deadline)
         {
-            m_current_ms = ImGui::get_current_time_msec();
+            if (m_count < 0 || (m_count > 0 && state.m_current_step < (uint32_t)m_count))
+            {
+                if (m_count > 0)
+                    state.m_current_step ++;
+                // next deadline follows the schedule, not the wake-up time, so events do not drift
+                state.m_deadline += interval;
+                if (state.m_deadline <= now_time)
+                    state.m_deadline = now_time + interval;     // fell behind, skip the missed events
+                context.PushReturnPoint(entryPoint);
+                return m_TimeOut;
+            }
+            state.m_current_step = 0;
+            state.m_deadline = {};
+            return m_Exit;
         }
 
+        // wait for the deadline on the executor's timer wheel without holding the thread
+        context.Suspend(state.m_deadline);
         context.PushReturnPoint(entryPoint);
-        
         return {};
     }
 
@@ -121,7 +119,5 @@ struct TimerNode final : Node
 
     uint32_t m_interval_ms   {0};
     int32_t m_count         {-1};
-    uint32_t m_current_step  {0};
-    uint64_t m_current_ms    {0};
 };
 } // namespace BluePrint
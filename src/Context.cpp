@@ -1,12 +1,120 @@
 #include <BluePrint.h>
 #include <Pin.h>
 #include <Node.h>
+#include <Executor.h>
 #include <inttypes.h>
 
-std::mutex g_Mutex;
-
 namespace BluePrint
 {
+void ContextSync::Publish(const ContextSnapshot& snapshot)
+{
+    // odd sequence marks a write in progress, CAS also keeps an occasional second writer out
+    auto sequence = m_Sequence.load(std::memory_order_relaxed);
+    while ((sequence & 1) || !m_Sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire, std::memory_order_relaxed))
+    {
+        std::this_thread::yield();
+        sequence = m_Sequence.load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    m_CurrentNode.store(snapshot.m_CurrentNode, std::memory_order_relaxed);
+    m_PrevNode.store(snapshot.m_PrevNode, std::memory_order_relaxed);
+    m_CurrentFlowPin.store(snapshot.m_CurrentFlowPin, std::memory_order_relaxed);
+    m_Sequence.store(sequence + 2, std::memory_order_release);
+}
+
+ContextSnapshot ContextSync::Snapshot() const
+{
+    ContextSnapshot snapshot;
+    while (true)
+    {
+        auto sequence = m_Sequence.load(std::memory_order_acquire);
+        if (sequence & 1)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        snapshot.m_CurrentNode = m_CurrentNode.load(std::memory_order_relaxed);
+        snapshot.m_PrevNode = m_PrevNode.load(std::memory_order_relaxed);
+        snapshot.m_CurrentFlowPin = m_CurrentFlowPin.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_Sequence.load(std::memory_order_relaxed) == sequence)
+            return snapshot;
+    }
+}
+
+void ContextSync::Post(uint32_t commands)
+{
+    m_Commands.fetch_or(commands, std::memory_order_release);
+    Wake();
+}
+
+uint32_t ContextSync::Take()
+{
+    return m_Commands.exchange(CMD_NONE, std::memory_order_acquire);
+}
+
+void ContextSync::Wake()
+{
+    // taking the lock orders the caller's state change before the waiter's predicate check
+    {
+        std::lock_guard<std::mutex> lock(m_WaitMutex);
+    }
+    m_WaitCondition.notify_all();
+}
+
+void ContextSync::Wait(const std::function<bool()>& ready)
+{
+    std::unique_lock<std::mutex> lock(m_WaitMutex);
+    m_WaitCondition.wait(lock, [&]()
+    {
+        return m_Commands.load(std::memory_order_acquire) != CMD_NONE || ready();
+    });
+}
+
+void ContextSync::WaitUntil(std::chrono::steady_clock::time_point time, const std::function<bool()>& ready)
+{
+    std::unique_lock<std::mutex> lock(m_WaitMutex);
+    m_WaitCondition.wait_until(lock, time, [&]()
+    {
+        return m_Commands.load(std::memory_order_acquire) != CMD_NONE || ready();
+    });
+}
+
+uint32_t ContextSync::Park()
+{
+    auto token = m_ParkCount.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (token == 0)
+        token = m_ParkCount.fetch_add(1, std::memory_order_relaxed) + 1;
+    m_Parked->store(token, std::memory_order_release);
+    // a Resume that came in before the run was parked is not lost
+    if ((m_Commands.fetch_and(~CMD_RESUME, std::memory_order_acq_rel) & CMD_RESUME) && Unpark(token))
+        return 0;
+    return token;
+}
+
+bool ContextSync::Unpark(const ParkCell& cell, uint32_t token)
+{
+    return token != 0 && cell->compare_exchange_strong(token, 0, std::memory_order_acq_rel);
+}
+
+static inline void NotifyMonitor(Context& context, void (ContextMonitor::*callback)(Context&))
+{
+    if (!context.m_Monitor)
+        return;
+    std::lock_guard<std::mutex> lock(context.MonitorMutex());
+    if (auto monitor = context.m_Monitor.load())
+        (monitor->*callback)(context);
+}
+
+// the UI swaps in its monitor under MonitorMutex, the execution thread must not change it halfway
+static inline void SwapMonitor(Context& context, ContextMonitor* monitor)
+{
+    if (context.m_Monitor == monitor)
+        return;
+    std::lock_guard<std::mutex> lock(context.MonitorMutex());
+    context.SetContextMonitor(monitor);
+}
+
 void Context::SetContextMonitor(ContextMonitor* monitor)
 {
     m_Monitor = monitor;
@@ -22,9 +130,90 @@ const ContextMonitor* Context::GetContextMonitor() const
     return m_Monitor;
 }
 
+void Context::CopySettings(const Context& other)
+{
+    m_Monitor = other.m_Monitor;
+    m_Executor = other.m_Executor;
+}
+
 void Context::ResetState()
 {
+    // slots are dropped by epoch and keep their storage, their payloads (e.g. ImMat buffers) are released now
+    if (++m_Epoch == 0)
+    {
+        std::fill(m_SlotEpochs.begin(), m_SlotEpochs.end(), 0);
+        m_Epoch = 1;
+    }
+    std::fill(m_SlotValues.begin(), m_SlotValues.end(), PinValue());
+    std::fill(m_CacheValues.begin(), m_CacheValues.end(), PinValue());
+    if (m_Plan && m_StateGeneration != m_Plan->m_Generation)
+    {
+        // nodes may have been deleted since states were made
+        m_NodeStates.clear();
+        m_StateGeneration = m_Plan->m_Generation;
+    }
+    if (m_Plan && m_SlotValues.size() < m_Plan->m_SlotCount)
+    {
+        m_SlotValues.resize(m_Plan->m_SlotCount);
+        m_SlotEpochs.resize(m_Plan->m_SlotCount, 0);
+    }
+    if (m_Plan && m_CacheValues.size() < m_Plan->m_SlotCount)
+    {
+        m_CacheValues.resize(m_Plan->m_SlotCount);
+        m_CacheEpochs.resize(m_Plan->m_SlotCount, 0);
+    }
     m_Values.clear();
+    m_Incremental = false;
+    m_DirtyNodes.clear();
+    InvalidateCache();
+}
+
+bool Context::ResetState(std::unordered_set<const Node*> dirtyNodes)
+{
+    // m_Epoch is left alone so slot values of clean nodes stay valid
+    m_Incremental = false;
+    m_DirtyNodes.clear();
+    if (!m_Plan || m_StateGeneration != m_Plan->m_Generation || m_SlotEpochs.size() < m_Plan->m_SlotCount)
+        return false;
+    m_Incremental = true;
+    m_DirtyNodes = std::move(dirtyNodes);
+    InvalidateCache();
+    return true;
+}
+
+bool Context::CanReplay(const Node& node) const
+{
+    if (!m_Incremental || m_DirtyNodes.count(&node))
+        return false;
+    auto stateIt = m_NodeStates.find(&node);
+    if (stateIt == m_NodeStates.end())
+        return false;
+    auto& state = *stateIt->second;
+    return state.m_Reusable && state.m_Epoch == m_Epoch;
+}
+
+void Context::DropPinValue(const Pin& pin)
+{
+    if (pin.m_Slot >= 0)
+    {
+        auto slot = static_cast<size_t>(pin.m_Slot);
+        if (slot < m_SlotEpochs.size())
+        {
+            m_SlotEpochs[slot] = 0;
+            m_SlotValues[slot] = PinValue();
+        }
+        return;
+    }
+    m_Values.erase(pin.m_ID);
+}
+
+void Context::InvalidateCache()
+{
+    if (++m_CacheEpoch == 0)
+    {
+        std::fill(m_CacheEpochs.begin(), m_CacheEpochs.end(), 0);
+        m_CacheEpoch = 1;
+    }
 }
 
 StepResult Context::Start(FlowPin& entryPoint, bool bypass_bg_node)
@@ -34,11 +223,17 @@ StepResult Context::Start(FlowPin& entryPoint, bool bypass_bg_node)
     m_CurrentNode = entryPoint.m_Node;
     m_CurrentFlowPin = entryPoint;
     m_StepCount = 0;
+    m_Suspended = false;
+    m_ExecThread = std::this_thread::get_id();
+    if (m_Plan && m_CacheEpochs.size() < m_Plan->m_SlotCount)
+    {
+        // branch contexts get their step cache on their first run
+        m_CacheValues.resize(m_Plan->m_SlotCount);
+        m_CacheEpochs.resize(m_Plan->m_SlotCount, 0);
+    }
+    Publish();
 
-    g_Mutex.lock();
-    if (m_Monitor)
-        m_Monitor->OnStart(*this);
-    g_Mutex.unlock();
+    NotifyMonitor(*this, &ContextMonitor::OnStart);
 
     if (m_CurrentNode == nullptr || m_CurrentFlowPin.m_ID == 0)
         return SetStepResult(StepResult::Error);
@@ -55,112 +250,163 @@ StepResult Context::Step(Context * context, bool restep)
         return context->m_LastResult;
 
     auto currentFlowPin = context->m_CurrentFlowPin;
-    g_Mutex.lock();
+    context->m_Suspended = false;
+    context->InvalidateCache();
     context->m_PrevNode = context->m_CurrentNode;
     context->m_PrevFlowPin = context->m_CurrentFlowPin;
     context->m_CurrentNode = nullptr;
     context->m_CurrentFlowPin = {};
-    g_Mutex.unlock();
+    context->Publish();
 
     if (currentFlowPin.m_ID == 0 && context->m_Callstack.empty())
         return context->SetStepResult(StepResult::Done);
 
-    auto entryPoint = context->GetPinValue(currentFlowPin, isthreading);
+    FlowPin* entryPin = nullptr;
+    auto instruction = context->m_Plan ? context->m_Plan->Resolve(currentFlowPin.m_ID) : nullptr;
+    if (instruction)
+    {
+        entryPin = instruction->m_Pin;
+    }
+    else
+    {
+        auto entryPoint = context->GetPinValue(currentFlowPin, isthreading);
 
-    if (entryPoint.GetType() != PinType::Flow)
-        return context->SetStepResult(StepResult::Error);
+        if (entryPoint.GetType() != PinType::Flow)
+            return context->SetStepResult(StepResult::Error);
 
-    auto entryPin = entryPoint.As<FlowPin*>();
+        entryPin = entryPoint.As<FlowPin*>();
+    }
 
-    g_Mutex.lock();
     context->m_CurrentNode = entryPin->m_Node;
-    g_Mutex.unlock();
+    context->Publish();
 
     ++m_StepCount;
 
-    g_Mutex.lock();
-    if (context->m_Monitor)
-        context->m_Monitor->OnPreStep(*context);
-    g_Mutex.unlock();
+    NotifyMonitor(*context, &ContextMonitor::OnPreStep);
     
     if (!entryPin->m_Node)
         return context->SetStepResult(StepResult::Done);
 
-    entryPin->m_Node->m_Hits ++;
-
-    auto start_time = ImGui::get_current_time_usec();
-    auto next = entryPin->m_Node->Execute(*context, *entryPin, isthreading);
-    auto end_time = ImGui::get_current_time_usec();
-    entryPin->m_Node->m_Tick += end_time - start_time;
-
-    entryPin->m_Node->m_HitCount ++;
-    entryPin->m_Node->m_CountTimeMs += entryPin->m_Node->m_NodeTimeMs;
-    if (entryPin->m_Node->m_HitCount > 100)
-    {
-        entryPin->m_Node->m_HitCount = 100;
-        entryPin->m_Node->m_CountTimeMs -= entryPin->m_Node->m_AvgTimeMs;
-    }
-    entryPin->m_Node->m_AvgTimeMs = entryPin->m_Node->m_HitCount > 0 ? entryPin->m_Node->m_CountTimeMs / entryPin->m_Node->m_HitCount : 0;
+    auto next = context->ExecuteNode(*entryPin->m_Node, *entryPin, isthreading);
 
     if (next.m_Node)
     {
-        auto bp = next.m_Node->m_Blueprint;
-        auto link = next.GetLink(bp);
-        while (link && link->IsMappedPin())
+        bool hasLink = false;
+        auto nextInstruction = context->m_Plan ? context->m_Plan->Find(next.m_ID) : nullptr;
+        if (nextInstruction)
         {
-            link = link->GetLink(bp);
+            hasLink = nextInstruction->m_HasLink;
+        }
+        else
+        {
+            auto bp = next.m_Node->m_Blueprint;
+            auto link = next.GetLink(bp);
+            while (link && link->IsMappedPin())
+            {
+                link = link->GetLink(bp);
+            }
+            hasLink = link && link->m_Type == PinType::Flow;
         }
-        if (link && link->m_Type == PinType::Flow)
+        if (hasLink)
         {
-            g_Mutex.lock();
             context->m_CurrentFlowPin = next;
-            g_Mutex.unlock();
         }
         else 
         {
             if (context->m_StepToEnd)
             {
-                g_Mutex.lock();
                 if (context->m_StepNode) context->m_CurrentNode = context->m_StepNode;
                 if (context->m_StepFlowPin) context->m_CurrentFlowPin = *context->m_StepFlowPin;
                 context->m_StepNode = nullptr;
                 context->m_StepToEnd = false;
-                g_Mutex.unlock();
             }
             else if (!context->m_Callstack.empty())
             {
-                g_Mutex.lock();
                 context->m_CurrentFlowPin = context->m_Callstack.back();
                 context->m_Callstack.pop_back();
-                g_Mutex.unlock();
             }
         }
     }
     else if (!context->m_Callstack.empty())
     {
-        g_Mutex.lock();
         context->m_CurrentFlowPin = context->m_Callstack.back();
         context->m_Callstack.pop_back();
-        g_Mutex.unlock();
     }
+    context->Publish();
 
-    g_Mutex.lock();
-    if (context->m_Monitor)
-        context->m_Monitor->OnPostStep(*context);
-    g_Mutex.unlock();
+    NotifyMonitor(*context, &ContextMonitor::OnPostStep);
 
     return context->SetStepResult(StepResult::Success);
 }
 
+// running average over the last 100 hits
+static void AddNodeTime(NodeState& state, int hits, double timeMs)
+{
+    state.m_HitCount += hits;
+    state.m_CountTimeMs += timeMs;
+    if (state.m_HitCount > 100)
+    {
+        state.m_CountTimeMs -= state.m_AvgTimeMs * (state.m_HitCount - 100);
+        state.m_HitCount = 100;
+    }
+    state.m_AvgTimeMs = state.m_HitCount > 0 ? state.m_CountTimeMs / state.m_HitCount : 0;
+}
+
+// primary context mirrors its counters on the node for the editor
+static void MirrorNodeTime(Node& node, const NodeState& state)
+{
+    node.m_Tick = state.m_Tick;
+    node.m_NodeTimeMs = state.m_NodeTimeMs;
+    node.m_HitCount = state.m_HitCount;
+    node.m_CountTimeMs = state.m_CountTimeMs;
+    node.m_AvgTimeMs = state.m_AvgTimeMs;
+}
+
+FlowPin Context::ExecuteNode(Node& node, FlowPin& entryPin, bool threading)
+{
+    auto& state = GetNodeState(node);
+    state.m_Hits ++;
+    if (!m_Shared)
+        node.m_Hits = state.m_Hits;
+
+    auto start_time = ImGui::get_current_time_usec();
+    FlowPin next;
+    if (state.m_Hits == 1 && state.m_Entry == entryPin.m_ID && CanReplay(node))
+    {
+        // inputs are unchanged since the last run, outputs are still in their slots
+        next = state.m_Next;
+    }
+    else
+    {
+#if !defined(__EMSCRIPTEN__)
+        if (auto inputs = m_Plan ? m_Plan->FindParallelInputs(node) : nullptr)
+            Prefetch(*inputs);
+#endif
+        auto depth = m_Callstack.size();
+        next = node.Execute(*this, entryPin, threading);
+        // nodes which run more than once or leave return points behind are not replayed
+        state.m_Reusable = state.m_Hits == 1 && depth == m_Callstack.size() && node.IsReusable();
+        state.m_Next = next;
+        state.m_Entry = entryPin.m_ID;
+        state.m_Epoch = m_Epoch;
+    }
+    auto end_time = ImGui::get_current_time_usec();
+    state.m_Tick += end_time - start_time;
+    state.m_NodeTimeMs = (end_time - start_time) / 1000.0;
+    AddNodeTime(state, 1, state.m_NodeTimeMs);
+    if (!m_Shared)
+        MirrorNodeTime(node, state);
+    return next;
+}
+
 StepResult Context::Restep(Context * context)
 {
     if (context->m_StepCount > 0)
     {
-        g_Mutex.lock();
         context->m_CurrentNode = context->m_PrevNode;
         context->m_Callstack.push_back(context->m_CurrentFlowPin);
         context->m_CurrentFlowPin = context->m_PrevFlowPin;
-        g_Mutex.unlock();
+        context->Publish();
         context->m_StepCount--;
         return Step(context, true);
     }
@@ -193,6 +439,15 @@ StepResult Context::Run(FlowPin& entryPoint, bool bypass_bg_node)
         result = Step();
         if (result != StepResult::Success)
             break;
+        if (m_Suspended)
+        {
+            // nothing else runs on this thread, sleep until the timeout or a Resume
+            if (m_WakeTime == std::chrono::steady_clock::time_point{})
+                m_Sync.Wait([]() { return false; });
+            else
+                m_Sync.WaitUntil(m_WakeTime, []() { return false; });
+            m_Sync.Take();
+        }
     }
     m_Executing = false;
     m_bypass_bg_node = false;
@@ -201,46 +456,89 @@ StepResult Context::Run(FlowPin& entryPoint, bool bypass_bg_node)
     m_PrevFlowPin = {};
     m_CurrentFlowPin = {};
     m_Callstack.clear();
+    Publish();
     return result;
 }
 
+static void RunSlice(Context& context);
+
+// Hands the worker back while the flow waits, false when the run was resumed meanwhile
+static bool ParkRun(Context& context)
+{
+    auto wakeTime = context.m_WakeTime;
+    auto cell = context.m_Sync.Parking();
+    auto& executor = context.m_Executor ? *context.m_Executor : Executor::GetDefault();
+    auto token = context.m_Sync.Park();
+    if (!token)
+        return false;
+    // from here on a Resume may already run the rest of the flow on another worker
+    if (wakeTime != std::chrono::steady_clock::time_point{})
+    {
+        executor.SubmitAt(wakeTime, [&context, cell, token]()
+        {
+            if (ContextSync::Unpark(cell, token))
+                RunSlice(context);
+        });
+    }
+    return true;
+}
+
 static void RunThread(Context& context, FlowPin& entryPoint, bool bypass_bg_node)
 {
-    ContextMonitor* monitor = context.m_Monitor;
-    BluePrint::StepResult result = BluePrint::StepResult::Done;
-    context.SetContextMonitor(nullptr);
+    // Stop() before a worker picked the run up
+    if (!context.m_Executing)
+    {
+        auto done = context.m_TaskDone;
+        context.m_ThreadRunning = false;
+        if (done) done->set_value();
+        return;
+    }
+    context.m_TaskMonitor = context.m_Monitor;
+    SwapMonitor(context, nullptr);
     context.Start(entryPoint, bypass_bg_node);
-    context.m_Executing = true;
-    context.m_ThreadRunning = true;
     context.m_pause_event = false;
+    RunSlice(context);
+}
+
+// Steps the run until it ends or a node suspends it, then continues from a timer or Context::Resume
+static void RunSlice(Context& context)
+{
+    ContextMonitor* monitor = context.m_TaskMonitor;
+    BluePrint::StepResult result = BluePrint::StepResult::Done;
+    context.m_ExecThread = std::this_thread::get_id();
     while (context.m_Executing)
     {
+        auto commands = context.m_Sync.Take();
+        if (commands & ContextSync::CMD_STEP_NEXT)      context.m_StepToNext = true;
+        if (commands & ContextSync::CMD_STEP_CURRENT)   context.m_StepCurrent = true;
+        if (commands & ContextSync::CMD_STEP_TO_END)    context.m_StepToEnd = true;
+
         if (context.m_Paused && !context.m_StepToNext && !context.m_StepCurrent && !context.m_StepToEnd)
         {
-            context.SetContextMonitor(monitor);
+            SwapMonitor(context, monitor);
             if (!context.m_pause_event)
             {
                 if (monitor) monitor->OnPause(context);
                 context.m_pause_event = true;
             }
-            ImGui::sleep(0.02f);
+            context.m_Sync.Wait([&context]() { return !context.m_Paused || !context.m_Executing; });
             continue;
         }
         else
         {
-            context.SetContextMonitor(nullptr);
+            SwapMonitor(context, nullptr);
         }
 
         if (context.m_Paused && context.m_StepCurrent)
         {
-            context.SetContextMonitor(monitor);
+            SwapMonitor(context, monitor);
             result = context.Restep(&context);
             if (monitor)  monitor->OnStepCurrent(context);
             context.m_StepCurrent = false;
         }
         else if (context.m_Paused && context.m_StepToNext)
         {
-            context.SetContextMonitor(monitor);
+            SwapMonitor(context, monitor);
             result = context.Step(&context);
             if (monitor)  monitor->OnStepNext(context);
             context.m_StepToNext = false;
@@ -258,8 +556,10 @@ static void RunThread(Context& context, FlowPin& entryPoint, bool bypass_bg_node
         }
         if (result != BluePrint::StepResult::Success)
             break;
-        std::this_thread::yield();
+        if (context.m_Suspended && context.m_Executing && !context.m_Paused && ParkRun(context))
+            return;
     }
+    auto done = context.m_TaskDone;
     context.m_Executing = false;
     context.m_Paused = false;
     context.m_ThreadRunning = false;
@@ -272,10 +572,11 @@ static void RunThread(Context& context, FlowPin& entryPoint, bool bypass_bg_node
     context.m_PrevFlowPin = {};
     context.m_CurrentFlowPin = {};
     context.m_Callstack.clear();
-    context.SetContextMonitor(monitor);
+    context.Publish();
+    SwapMonitor(context, monitor);
     LOGI("Execution: Finished at step %" PRIu32, context.StepCount());
     context.SetStepResult(BluePrint::StepResult::Done);
-    return;
+    if (done) done->set_value();
 }
 
 StepResult Context::Execute(FlowPin& entryPoint, bool bypass_bg_node)
@@ -285,42 +586,44 @@ StepResult Context::Execute(FlowPin& entryPoint, bool bypass_bg_node)
     {
         m_Paused = false;
         m_pause_event = false;
-        g_Mutex.lock();
-        if (m_Monitor)
-            m_Monitor->OnResume(*this);
-        g_Mutex.unlock();
+        m_Sync.Wake();
+        NotifyMonitor(*this, &ContextMonitor::OnResume);
         return SetStepResult(StepResult::Success);
     }
-    if (m_thread)
+    if (m_Task.valid())
     {
         m_Executing = false;
-        if (m_thread->joinable())
-        {
-            m_thread->join();
-            delete m_thread;
-            m_thread = nullptr;
-        }
+        m_Sync.Wake();
+        Resume();
+        m_Task.wait();
+        m_Task = {};
     }
-    m_thread = new std::thread(RunThread, std::ref(*this), std::ref(entryPoint), bypass_bg_node);
+    auto executor = m_Executor ? m_Executor : &Executor::GetDefault();
+    m_Executing = true;
+    m_ThreadRunning = true;
+    m_TaskDone = std::make_shared<std::promise<void>>();
+    m_Task = m_TaskDone->get_future().share();
+    executor->Submit([this, &entryPoint, bypass_bg_node]()
+    {
+        RunThread(*this, entryPoint, bypass_bg_node);
+    });
     return result;
 }
 
 StepResult Context::Stop()
 {
-    if (m_ThreadRunning && m_Executing && m_thread)
+    if (m_ThreadRunning && m_Executing && m_Task.valid())
     {
         m_Executing = false;
-        if (m_thread->joinable())
-        {
-            m_thread->join();
-            delete m_thread;
-            m_thread = nullptr;
-        }
+        m_Sync.Wake();
+        Resume();
+        m_Task.wait();
+        m_Task = {};
         return SetStepResult(StepResult::Success);
     }
-    else if (m_thread)
+    else if (m_Task.valid())
     {
-        m_thread = nullptr;
+        m_Task = {};
     }
 
     if (m_LastResult != StepResult::Success)
@@ -331,6 +634,7 @@ StepResult Context::Stop()
     m_PrevFlowPin = {};
     m_CurrentFlowPin = {};
     m_Callstack.clear();
+    Publish();
 
     return SetStepResult(StepResult::Done);
 }
@@ -344,14 +648,14 @@ StepResult Context::Pause()
 StepResult Context::ThreadStep()
 {
     if (m_Paused)
-        m_StepToNext = true;
+        m_Sync.Post(ContextSync::CMD_STEP_NEXT);
     return SetStepResult(StepResult::Success);
 }
 
 StepResult Context::ThreadRestep()
 {
     if (m_Paused)
-        m_StepCurrent = true;
+        m_Sync.Post(ContextSync::CMD_STEP_CURRENT);
     return SetStepResult(StepResult::Success);
 }
 
@@ -359,30 +663,30 @@ StepResult Context::ThreadStepToEnd(Node* node)
 {
     if (m_Paused)
     {
-        m_StepToEnd = true;
         if (node)
         {
-            g_Mutex.lock();
             m_StepNode = node;
             m_CurrentNode = node;
             m_StepFlowPin = (FlowPin *)node->GetAutoLinkInputFlowPin();
-            g_Mutex.unlock();
+            Publish();
         }
+        m_Sync.Post(ContextSync::CMD_STEP_TO_END);
     }
     return SetStepResult(StepResult::Success);
 }
 
 void Context::ShowFlow()
 {
-    if (!m_CurrentNode)
+    auto snapshot = m_Sync.Snapshot();
+    if (!snapshot.m_CurrentNode)
     {
         return;
     }
     ed::PushStyleVar(ed::StyleVar_FlowMarkerDistance, 30.0f);
     ed::PushStyleVar(ed::StyleVar_FlowDuration, 1.0f);
-    if (m_PrevNode)
+    if (snapshot.m_PrevNode)
     {
-        for (auto pin : m_PrevNode->GetOutputPins())
+        for (auto pin : snapshot.m_PrevNode->GetOutputPins())
         {
             if (!pin->m_Link || !pin->m_Node)
                 continue;
@@ -392,7 +696,7 @@ void Context::ShowFlow()
             {
                 link = link->GetLink(bp);
             }
-            if (!link || link->m_Node != m_CurrentNode)
+            if (!link || link->m_Node != snapshot.m_CurrentNode)
                 continue;
             ed::Flow(pin->m_ID, pin->GetType() == PinType::Flow ? ed::FlowDirection::Forward : ed::FlowDirection::Backward);
             link = pin->GetLink();
@@ -404,9 +708,9 @@ void Context::ShowFlow()
         }
     }
 
-    if (m_CurrentNode)
+    if (snapshot.m_CurrentNode)
     {
-        for (auto pin : m_CurrentNode->GetInputPins())
+        for (auto pin : snapshot.m_CurrentNode->GetInputPins())
         {
             if (!pin->m_Link || !pin->m_Node)
                 continue;
@@ -433,43 +737,30 @@ void Context::ShowFlow()
 
 Node* Context::CurrentNode()
 {
-    return m_CurrentNode;
+    return m_Sync.Snapshot().m_CurrentNode;
 }
 
 const Node* Context::CurrentNode() const
 {
-    return m_CurrentNode;
+    return m_Sync.Snapshot().m_CurrentNode;
 }
 
 Node* Context::NextNode()
 {
-    g_Mutex.lock();
-    auto node = m_CurrentFlowPin.m_Node;
-    if (m_CurrentFlowPin.m_Link)
-    {
-        auto bp = node->m_Blueprint;
-        auto link = m_CurrentFlowPin.GetLink(bp);
-        while (link && !link->IsMappedPin())
-        {
-            node = link->m_Node;
-            link = link->GetLink(bp);
-        }
-        if (link)
-            node = link->m_Node;
-    }
-
-    g_Mutex.unlock();
-    return node;
+    return const_cast<Node*>(const_cast<const Context*>(this)->NextNode());
 }
 
 const Node* Context::NextNode() const
 {
-    g_Mutex.lock();
-    auto node = m_CurrentFlowPin.m_Node;
-    if (m_CurrentFlowPin.m_Link)
+    auto flowPin = m_Sync.Snapshot().m_CurrentFlowPin;
+    if (!flowPin)
+        return nullptr;
+
+    auto node = flowPin->m_Node;
+    if (node && flowPin->m_Link)
     {
         auto bp = node->m_Blueprint;
-        auto link = m_CurrentFlowPin.GetLink(bp);
+        auto link = flowPin->GetLink(bp);
         while (link && !link->IsMappedPin())
         {
             node = link->m_Node;
@@ -478,13 +769,15 @@ const Node* Context::NextNode() const
         if (link)
             node = link->m_Node;
     }
-    g_Mutex.unlock();
     return node;
 }
 
 FlowPin Context::CurrentFlowPin() const
 {
-    return m_CurrentFlowPin;
+    auto flowPin = m_Sync.Snapshot().m_CurrentFlowPin;
+    if (!flowPin)
+        return {};
+    return *flowPin;
 }
 
 StepResult Context::LastStepResult() const
@@ -502,16 +795,268 @@ void Context::PushReturnPoint(FlowPin& entryPoint)
     m_Callstack.push_back(entryPoint);
 }
 
+void Context::PopReturnPoint()
+{
+    if (!m_Callstack.empty())
+        m_Callstack.pop_back();
+}
+
+void Context::Suspend(int32_t timeoutMs)
+{
+    m_Suspended = true;
+    m_WakeTime = {};
+    if (timeoutMs >= 0)
+        m_WakeTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+}
+
+void Context::Suspend(std::chrono::steady_clock::time_point wakeTime)
+{
+    m_Suspended = true;
+    m_WakeTime = wakeTime;
+}
+
+void Context::Resume()
+{
+    m_Sync.Post(ContextSync::CMD_RESUME);
+    if (m_Sync.Unpark(m_Sync.Parked()))
+    {
+        auto& executor = m_Executor ? *m_Executor : Executor::GetDefault();
+        executor.Submit([this]() { RunSlice(*this); });
+    }
+}
+
+bool Context::CanRunInline() const
+{
+    // monitors and pause requests need the scheduler to see every step
+    return m_Executing && !m_Paused && !m_Monitor;
+}
+
+StepResult Context::RunInline(FlowPin& bodyPin, bool threading)
+{
+    // registered pin behind an output flow pin when it leads anywhere, same test as Step
+    auto follow = [this](const FlowPin& pin) -> FlowPin*
+    {
+        if (!pin.m_Node)
+            return nullptr;
+        auto instruction = m_Plan ? m_Plan->Find(pin.m_ID) : nullptr;
+        if (instruction)
+            return instruction->m_HasLink ? instruction->m_Pin : nullptr;
+        auto bp = pin.m_Node->m_Blueprint;
+        return pin.GetLink(bp) ? static_cast<FlowPin*>(bp->GetPinFromID(pin.m_ID)) : nullptr;
+    };
+
+    auto depth = m_Callstack.size();
+    FlowPin* current = follow(bodyPin);
+    while (current)
+    {
+        FlowPin* entryPin = nullptr;
+        auto instruction = m_Plan ? m_Plan->Resolve(current->m_ID) : nullptr;
+        if (instruction)
+        {
+            entryPin = instruction->m_Pin;
+        }
+        else
+        {
+            auto entryPoint = GetPinValue(*current, threading);
+            if (entryPoint.GetType() != PinType::Flow)
+            {
+                m_Callstack.resize(depth);
+                return StepResult::Error;
+            }
+            entryPin = entryPoint.As<FlowPin*>();
+        }
+        auto node = entryPin->m_Node;
+        if (!node)
+        {
+            m_Callstack.resize(depth);
+            return StepResult::Error;
+        }
+        if (node->m_BreakPoint)
+        {
+            // let Step enter the node, the debugger stops there as usual
+            m_Callstack.push_back(*entryPin);
+            return StepResult::Done;
+        }
+
+        ++m_StepCount;
+        InvalidateCache();
+        auto next = ExecuteNode(*node, *entryPin, threading);
+        if (m_Callstack.size() < depth)
+            return StepResult::Done;    // exit nodes drop the callstack, the whole run ends
+        if (m_Suspended)
+            return StepResult::Done;    // the waiting node pushed its return point, Step parks the run
+
+        current = follow(next);
+        if (!current && m_Callstack.size() > depth)
+        {
+            // a nested loop returns to its own entry
+            auto returnPin = m_Callstack.back();
+            m_Callstack.pop_back();
+            auto returnInstruction = m_Plan ? m_Plan->Find(returnPin.m_ID) : nullptr;
+            if (returnInstruction)
+                current = returnInstruction->m_Pin;
+            else
+                current = static_cast<FlowPin*>(returnPin.m_Node->m_Blueprint->GetPinFromID(returnPin.m_ID));
+        }
+    }
+    return StepResult::Success;
+}
+
 void Context::SetPinValue(const Pin& pin, PinValue value)
 {
+    // anything evaluated so far may depend on this pin
+    InvalidateCache();
+    if (m_Parent)
+        m_Written.insert(&pin);
+    if (pin.m_Slot >= 0)
+    {
+        auto slot = static_cast<size_t>(pin.m_Slot);
+        if (slot >= m_SlotValues.size())
+        {
+            m_SlotValues.resize(slot + 1);
+            m_SlotEpochs.resize(slot + 1, 0);
+        }
+        m_SlotValues[slot] = std::move(value);
+        m_SlotEpochs[slot] = m_Epoch;
+        return;
+    }
     m_Values[pin.m_ID] = std::move(value);
 }
 
+void Context::Prefetch(const std::vector<const Pin*>& pins)
+{
+    if (std::this_thread::get_id() != m_ExecThread)
+        return;
+
+    std::vector<const Pin*> pending;
+    for (auto pin : pins)
+    {
+        auto slot = static_cast<size_t>(pin->m_Slot);
+        if (slot >= m_CacheEpochs.size() || m_CacheEpochs[slot] == m_CacheEpoch)
+            continue;
+        if (FindStoredValue(*pin))
+            continue;
+        pending.push_back(pin);
+    }
+    if (pending.size() < 2)
+        return;
+
+    // workers only read the context, results reach the cache from this thread once all are done
+    auto& executor = m_Executor ? *m_Executor : Executor::GetDefault();
+    std::vector<PinValue> values(pending.size());
+    std::vector<std::shared_future<void>> tasks;
+    tasks.reserve(pending.size() - 1);
+    for (size_t i = 1; i < pending.size(); i++)
+    {
+        tasks.push_back(executor.Submit([this, &values, &pending, i]()
+        {
+            values[i] = GetPinValue(*pending[i], true);
+        }, true));
+    }
+    values[0] = GetPinValue(*pending[0]);
+    for (auto& task : tasks)
+        executor.Wait(task);
+
+    for (size_t i = 1; i < pending.size(); i++)
+    {
+        auto slot = static_cast<size_t>(pending[i]->m_Slot);
+        m_CacheValues[slot] = std::move(values[i]);
+        m_CacheEpochs[slot] = m_CacheEpoch;
+    }
+}
+
+std::unique_ptr<Context> Context::Fork()
+{
+    // values are not copied, the child reads through to us for anything it has not set itself
+    auto child = std::make_unique<Context>();
+    child->m_Parent = this;
+    child->m_Shared = true;
+    child->m_bypass_bg_node = m_bypass_bg_node;
+    child->m_Plan = m_Plan;
+    child->m_Executor = m_Executor;
+    child->m_StateGeneration = m_StateGeneration;
+    return child;
+}
+
+void Context::Merge(const Context& child)
+{
+    for (auto pin : child.m_Written)
+    {
+        auto slot = static_cast<size_t>(pin->m_Slot);
+        if (pin->m_Slot >= 0 && slot < child.m_SlotEpochs.size() && child.m_SlotEpochs[slot] == child.m_Epoch)
+        {
+            SetPinValue(*pin, child.m_SlotValues[slot]);
+            continue;
+        }
+        auto valueIt = child.m_Values.find(pin->m_ID);
+        if (valueIt != child.m_Values.end())
+            SetPinValue(*pin, valueIt->second);
+    }
+
+    // nodes run in the branch count towards our timing, so the editor sees them too
+    for (auto& entry : child.m_NodeStates)
+    {
+        auto& childState = *entry.second;
+        if (childState.m_HitCount == 0)
+            continue;
+        auto& state = GetNodeState(*entry.first);
+        state.m_Tick += childState.m_Tick;
+        state.m_NodeTimeMs = childState.m_NodeTimeMs;
+        AddNodeTime(state, childState.m_HitCount, childState.m_CountTimeMs);
+        if (!m_Shared)
+            MirrorNodeTime(const_cast<Node&>(*entry.first), state);
+    }
+}
+
+NodeState& Context::GetNodeState(const Node& node)
+{
+    auto& state = m_NodeStates[&node];
+    if (!state)
+        state.reset(node.CreateState());
+    return *state;
+}
+
+const PinValue* Context::FindStoredValue(const Pin& pin) const
+{
+    // a branch context falls back to the values its parents had when it was forked
+    for (auto context = this; context; context = context->m_Parent)
+    {
+        if (pin.m_Slot >= 0)
+        {
+            auto slot = static_cast<size_t>(pin.m_Slot);
+            if (slot < context->m_SlotEpochs.size() && context->m_SlotEpochs[slot] == context->m_Epoch)
+                return &context->m_SlotValues[slot];
+        }
+        else if (!context->m_Values.empty())
+        {
+            auto valueIt = context->m_Values.find(pin.m_ID);
+            if (valueIt != context->m_Values.end())
+                return &valueIt->second;
+        }
+    }
+    return nullptr;
+}
+
+const PinValue* Context::PeekPinValue(const Pin& pin) const
+{
+    // valid until the slot is written again, only the executing thread sees the step cache
+    if (auto stored = FindStoredValue(pin))
+        return stored;
+    if (!pin.m_Node)
+        return nullptr;
+    if (auto link = pin.GetLink(pin.m_Node->m_Blueprint))
+        return PeekPinValue(*link);
+    auto slot = static_cast<size_t>(pin.m_Slot);
+    if (pin.m_Slot >= 0 && slot < m_CacheEpochs.size() && m_CacheEpochs[slot] == m_CacheEpoch &&
+        std::this_thread::get_id() == m_ExecThread)
+        return &m_CacheValues[slot];
+    return nullptr;
+}
+
 PinValue Context::GetPinValue(const Pin& pin, bool threading) const
 {
-    auto valueIt = m_Values.find(pin.m_ID);
-    if (valueIt != m_Values.end())
-        return valueIt->second;
+    if (auto stored = FindStoredValue(pin))
+        return *stored;
 
     if (!pin.m_Node)
         return pin.GetValue();
@@ -522,7 +1067,20 @@ PinValue Context::GetPinValue(const Pin& pin, bool threading) const
     if (link)
         value = GetPinValue(*link);
     else if (pin.m_Node)
+    {
+        // shared upstream pins are evaluated once per step
+        auto slot = static_cast<size_t>(pin.m_Slot);
+        bool memoize = pin.m_Slot >= 0 && slot < m_CacheEpochs.size() && pin.m_Type != PinType::Flow &&
+                        std::this_thread::get_id() == m_ExecThread && pin.m_Node->IsMemoizable();
+        if (memoize && m_CacheEpochs[slot] == m_CacheEpoch)
+            return m_CacheValues[slot];
         value = pin.m_Node->EvaluatePin(*this, pin, threading);
+        if (memoize)
+        {
+            m_CacheValues[slot] = value;
+            m_CacheEpochs[slot] = m_CacheEpoch;
+        }
+    }
     else
         value = pin.GetValue();
 
@@ -532,25 +1090,36 @@ PinValue Context::GetPinValue(const Pin& pin, bool threading) const
 StepResult Context::SetStepResult(StepResult result)
 {
     m_LastResult = result;
-    g_Mutex.lock();
-    if (m_Monitor)
+    switch (result)
     {
-        switch (result)
-        {
-            case StepResult::Done:
-                m_Monitor->OnDone(*this);
-                break;
+        case StepResult::Done:
+            NotifyMonitor(*this, &ContextMonitor::OnDone);
+            break;
 
-            case StepResult::Error:
-                m_Monitor->OnError(*this);
-                break;
-            
-            default:
-                break;
-        }
+        case StepResult::Error:
+            NotifyMonitor(*this, &ContextMonitor::OnError);
+            break;
+        
+        default:
+            break;
     }
-    g_Mutex.unlock();
 
     return result;
 }
+
+void Context::Publish()
+{
+    ContextSnapshot snapshot;
+    snapshot.m_CurrentNode = m_CurrentNode;
+    snapshot.m_PrevNode = m_PrevNode;
+    if (m_CurrentFlowPin.m_ID)
+    {
+        // m_CurrentFlowPin is a copy, readers get the pin owned by the graph
+        if (auto instruction = m_Plan ? m_Plan->Find(m_CurrentFlowPin.m_ID) : nullptr)
+            snapshot.m_CurrentFlowPin = instruction->m_Pin;
+        else if (m_CurrentFlowPin.m_Node && m_CurrentFlowPin.m_Node->m_Blueprint)
+            snapshot.m_CurrentFlowPin = dynamic_cast<FlowPin*>(m_CurrentFlowPin.m_Node->m_Blueprint->FindPin(m_CurrentFlowPin.m_ID));
+    }
+    m_Sync.Publish(snapshot);
+}
 } // namespace BluePrint
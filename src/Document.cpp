@@ -1,4 +1,5 @@
 #include <Document.h>
+#include <BinaryFormat.h>
 #include <Utils.h>
 #include <Debug.h>
 
@@ -309,9 +310,47 @@ int Document::Deserialize(const imgui_json::value& value, Document& result)
     return BP_ERR_NONE;
 }
 
+// Blueprint nodes are created from the node records, the blueprint json is decoded for the document state only
+int Document::Deserialize(const BinaryDocument& document, Document& result)
+{
+    auto root = document.Root();
+    auto documentValue = document.Member(root, "document");
+    auto viewValue = document.Member(root, "view");
+    if (documentValue == BP_BINARY_NONE || viewValue == BP_BINARY_NONE)
+        return BP_ERR_DOC_LOAD;
+
+    auto nodesValue = document.Member(documentValue, "nodes");
+    auto selectionValue = document.Member(documentValue, "selection");
+    auto blueprintValue = document.Member(documentValue, "blueprint");
+    if (nodesValue == BP_BINARY_NONE || selectionValue == BP_BINARY_NONE || blueprintValue == BP_BINARY_NONE ||
+        document.Value(nodesValue).m_Type != BinaryValueType::Object)
+        return BP_ERR_DOC_LOAD;
+
+    DocumentState state;
+    state.m_NodesState = document.Decode(nodesValue);
+    state.m_SelectionState = document.Decode(selectionValue);
+    state.m_BlueprintState = document.Decode(blueprintValue);
+    result.m_NavigationState.m_ViewState = document.Decode(viewValue);
+
+    if (result.m_Blueprint.Load(document, blueprintValue) != 0)
+        return BP_ERR_DOC_LOAD;
+
+    result.m_DocumentState = std::move(state);
+
+    return BP_ERR_NONE;
+}
+
 int Document::Load(std::string path)
 {
     int ret = BP_ERR_NONE;
+    if (BinaryDocument::IsBinaryFile(path))
+    {
+        BinaryDocument document;
+        if (!document.Open(path))
+            return BP_ERR_DOC_LOAD;
+        return Deserialize(document, *this);
+    }
+
     auto loadResult = imgui_json::value::load(path);
     if (!loadResult.second)
         return BP_ERR_DOC_LOAD;
@@ -325,7 +364,7 @@ int Document::Load(std::string path)
 int Document::Import(std::string path, ImVec2 pos)
 {
     int ret = BP_ERR_NONE;
-    auto loadResult = imgui_json::value::load(path);
+    auto loadResult = BinaryDocument::IsBinaryFile(path) ? BinaryDocument::Load(path) : imgui_json::value::load(path);
     if (!loadResult.second)
         return BP_ERR_GROUP_LOAD;
 
@@ -338,6 +377,11 @@ bool Document::Save(std::string path) const
     return result.save(path);
 }
 
+bool Document::SaveBinary(std::string path) const
+{
+    return BinaryDocument::Save(Serialize(), path);
+}
+
 bool Document::Save() const
 {
     if (m_Path.empty())
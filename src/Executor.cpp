@@ -0,0 +1,147 @@
+#include <Executor.h>
+#include <algorithm>
+
+namespace BluePrint
+{
+static size_t DefaultWorkerCount()
+{
+    auto count = std::thread::hardware_concurrency();
+    return count > 0 ? count : 4;
+}
+
+Executor::Executor(size_t workers)
+{
+    SetWorkerCount(workers);
+}
+
+Executor::~Executor()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Quit = true;
+    }
+    m_Condition.notify_all();
+    for (auto& worker : m_Workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+}
+
+std::shared_future<void> Executor::Submit(Task task, bool nested)
+{
+    auto job = std::make_shared<std::packaged_task<void()>>(std::move(task));
+    auto future = job->get_future().share();
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Queue.push_back({[job]() { (*job)(); }, nested});
+    }
+    m_Condition.notify_one();
+    return future;
+}
+
+std::shared_future<void> Executor::SubmitAt(std::chrono::steady_clock::time_point time, Task task)
+{
+    auto job = std::make_shared<std::packaged_task<void()>>(std::move(task));
+    auto future = job->get_future().share();
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Timers.Add(time, [job]() { (*job)(); });
+    }
+    // sleeping workers may wait for a later deadline
+    m_Condition.notify_all();
+    return future;
+}
+
+void Executor::Wait(const std::shared_future<void>& future)
+{
+    // a worker waiting for its own nested tasks helps instead of blocking, so a busy pool cannot deadlock
+    while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+        Task task;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            auto jobIt = std::find_if(m_Queue.begin(), m_Queue.end(), [](const Job& job) { return job.m_Nested; });
+            if (jobIt != m_Queue.end())
+            {
+                task = std::move(jobIt->m_Task);
+                m_Queue.erase(jobIt);
+            }
+        }
+        if (task)
+            task();
+        else
+            future.wait_for(std::chrono::microseconds(100));
+    }
+}
+
+void Executor::SetWorkerCount(size_t workers)
+{
+    if (workers == 0)
+        workers = DefaultWorkerCount();
+
+    std::vector<std::thread> retired;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_WorkerTarget = workers;
+        while (m_Workers.size() < workers)
+            m_Workers.emplace_back(&Executor::WorkerLoop, this, m_Workers.size());
+        while (m_Workers.size() > workers)
+        {
+            retired.emplace_back(std::move(m_Workers.back()));
+            m_Workers.pop_back();
+        }
+    }
+    m_Condition.notify_all();
+    for (auto& worker : retired)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+}
+
+size_t Executor::GetWorkerCount() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Workers.size();
+}
+
+Executor& Executor::GetDefault()
+{
+    static Executor executor;
+    return executor;
+}
+
+void Executor::WorkerLoop(size_t index)
+{
+    while (true)
+    {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            while (true)
+            {
+                if (m_Quit || index >= m_WorkerTarget)
+                    return;
+                // due timers join the run queue in deadline order
+                if (!m_Timers.Empty())
+                {
+                    std::vector<Task> expired;
+                    m_Timers.Advance(std::chrono::steady_clock::now(), expired);
+                    for (auto& timer : expired)
+                        m_Queue.push_back({std::move(timer), false});
+                }
+                if (!m_Queue.empty())
+                    break;
+                if (m_Timers.Empty())
+                    m_Condition.wait(lock);
+                else
+                    m_Condition.wait_until(lock, m_Timers.NextExpiry());
+            }
+            task = std::move(m_Queue.front().m_Task);
+            m_Queue.pop_front();
+        }
+        task();
+    }
+}
+} // namespace BluePrint
@@ -0,0 +1,658 @@
+#include <MatKernel.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) && !defined(__EMSCRIPTEN__)
+#define MAT_KERNEL_X86 1
+#define MAT_TARGET(isa) __attribute__((target(isa)))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define MAT_KERNEL_X86 1
+#define MAT_TARGET(isa)
+#include <intrin.h>
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define MAT_KERNEL_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace BluePrint
+{
+# pragma region Scalar
+// Broadcast values saturate into the element range, NaN gives 0
+template <typename T>
+static inline T SaturateFromDouble(double v)
+{
+    if (v != v)
+        return 0;
+    if (v <= static_cast<double>(std::numeric_limits<T>::min()))
+        return std::numeric_limits<T>::min();
+    if (v >= static_cast<double>(std::numeric_limits<T>::max()))
+        return std::numeric_limits<T>::max();
+    return static_cast<T>(v);
+}
+
+// 32 and 64 bit integers wrap like the vector kernels (add/sub/mullo), done unsigned so it is not UB
+template <typename T>
+struct MatScalar
+{
+    using U = std::make_unsigned_t<T>;
+    static T FromDouble(double v) { return SaturateFromDouble<T>(v); }
+    static T Add(T a, T b) { return static_cast<T>(static_cast<U>(a) + static_cast<U>(b)); }
+    static T Sub(T a, T b) { return static_cast<T>(static_cast<U>(a) - static_cast<U>(b)); }
+    static T Mul(T a, T b) { return static_cast<T>(static_cast<U>(a) * static_cast<U>(b)); }
+    static T Div(T a, T b) { return b == 0 ? std::numeric_limits<T>::max() : (b == -1 ? Sub(0, a) : a / b); }
+};
+
+// 8 and 16 bit pixels saturate instead of wrapping
+template <typename T>
+struct MatSaturated
+{
+    static T Clamp(int32_t v) { return static_cast<T>(std::min<int32_t>(std::max<int32_t>(v, std::numeric_limits<T>::min()), std::numeric_limits<T>::max())); }
+    static T FromDouble(double v) { return SaturateFromDouble<T>(v); }
+    static T Add(T a, T b) { return Clamp(int32_t(a) + int32_t(b)); }
+    static T Sub(T a, T b) { return Clamp(int32_t(a) - int32_t(b)); }
+    static T Mul(T a, T b) { return Clamp(int32_t(a) * int32_t(b)); }
+    static T Div(T a, T b) { return b == 0 ? std::numeric_limits<T>::max() : Clamp(int32_t(a) / int32_t(b)); }
+};
+template <> struct MatScalar<uint8_t> : MatSaturated<uint8_t> {};
+template <> struct MatScalar<int16_t> : MatSaturated<int16_t> {};
+
+template <typename T>
+struct MatFloating
+{
+    static T FromDouble(double v) { return static_cast<T>(v); }
+    static T Add(T a, T b) { return a + b; }
+    static T Sub(T a, T b) { return a - b; }
+    static T Mul(T a, T b) { return a * b; }
+    static T Div(T a, T b) { return a / (b + 1e-10f); }
+};
+template <> struct MatScalar<float> : MatFloating<float> {};
+template <> struct MatScalar<double> : MatFloating<double> {};
+
+template <typename T, typename F>
+static inline void MatLoop(const T* a, const T* b, bool broadcast, T* out, size_t n, F f)
+{
+    if (broadcast)
+    {
+        auto s = *b;
+        for (size_t i = 0; i < n; i++)
+            out[i] = f(a[i], s);
+    }
+    else
+    {
+        for (size_t i = 0; i < n; i++)
+            out[i] = f(a[i], b[i]);
+    }
+}
+
+template <typename T>
+static void MatScalarKernel(MatOp op, const T* a, const T* b, bool broadcast, T* out, size_t n)
+{
+    using S = MatScalar<T>;
+    switch (op)
+    {
+        case MatOp::Add: MatLoop(a, b, broadcast, out, n, S::Add); break;
+        case MatOp::Sub: MatLoop(a, b, broadcast, out, n, S::Sub); break;
+        case MatOp::Mul: MatLoop(a, b, broadcast, out, n, S::Mul); break;
+        case MatOp::Div: MatLoop(a, b, broadcast, out, n, S::Div); break;
+    }
+}
+
+// true when v is exactly an element of T, then the element kernels give the same result as wide math
+template <typename T>
+static inline bool IsElementValue(double v)
+{
+    return v == trunc(v) && v >= static_cast<double>(std::numeric_limits<T>::min()) && v <= static_cast<double>(std::numeric_limits<T>::max());
+}
+
+static bool IsElementValue(ImDataType type, double v)
+{
+    switch (type)
+    {
+        case IM_DT_INT8:    return IsElementValue<uint8_t>(v);
+        case IM_DT_INT16:   return IsElementValue<int16_t>(v);
+        case IM_DT_INT32:   return IsElementValue<int32_t>(v);
+        case IM_DT_INT64:   return IsElementValue<int64_t>(v);
+        default:            return true;    // floating point takes any value
+    }
+}
+
+// Integer elements with a broadcast value that is no element (fraction, out of range) are computed in double,
+// only the result saturates. b is never 0 here, 0 is an element value
+template <typename T>
+static void MatWideKernel(MatOp op, const T* a, double b, T* out, size_t n)
+{
+    switch (op)
+    {
+        case MatOp::Add: for (size_t i = 0; i < n; i++) out[i] = SaturateFromDouble<T>(static_cast<double>(a[i]) + b); break;
+        case MatOp::Sub: for (size_t i = 0; i < n; i++) out[i] = SaturateFromDouble<T>(static_cast<double>(a[i]) - b); break;
+        case MatOp::Mul: for (size_t i = 0; i < n; i++) out[i] = SaturateFromDouble<T>(static_cast<double>(a[i]) * b); break;
+        case MatOp::Div: for (size_t i = 0; i < n; i++) out[i] = SaturateFromDouble<T>(static_cast<double>(a[i]) / b); break;
+    }
+}
+# pragma endregion
+
+// Vector kernels return how many leading elements they handled, the scalar kernel does the rest
+template <typename T>
+using MatVectorKernel = size_t (*)(MatOp op, const T* a, const T* b, bool broadcast, T* out, size_t n);
+
+#if MAT_KERNEL_X86
+# pragma region AVX2
+MAT_TARGET("avx2") static size_t Avx2Float(MatOp op, const float* a, const float* b, bool broadcast, float* out, size_t n)
+{
+    size_t i = 0;
+    const __m256 s = _mm256_set1_ps(*b);
+    const __m256 eps = _mm256_set1_ps(1e-10f);
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256 x = _mm256_loadu_ps(a + i);
+        __m256 y = broadcast ? s : _mm256_loadu_ps(b + i);
+        switch (op)
+        {
+            case MatOp::Add: x = _mm256_add_ps(x, y); break;
+            case MatOp::Sub: x = _mm256_sub_ps(x, y); break;
+            case MatOp::Mul: x = _mm256_mul_ps(x, y); break;
+            case MatOp::Div: x = _mm256_div_ps(x, _mm256_add_ps(y, eps)); break;
+        }
+        _mm256_storeu_ps(out + i, x);
+    }
+    return i;
+}
+
+MAT_TARGET("avx2") static size_t Avx2Double(MatOp op, const double* a, const double* b, bool broadcast, double* out, size_t n)
+{
+    size_t i = 0;
+    const __m256d s = _mm256_set1_pd(*b);
+    const __m256d eps = _mm256_set1_pd(1e-10f);
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256d x = _mm256_loadu_pd(a + i);
+        __m256d y = broadcast ? s : _mm256_loadu_pd(b + i);
+        switch (op)
+        {
+            case MatOp::Add: x = _mm256_add_pd(x, y); break;
+            case MatOp::Sub: x = _mm256_sub_pd(x, y); break;
+            case MatOp::Mul: x = _mm256_mul_pd(x, y); break;
+            case MatOp::Div: x = _mm256_div_pd(x, _mm256_add_pd(y, eps)); break;
+        }
+        _mm256_storeu_pd(out + i, x);
+    }
+    return i;
+}
+
+MAT_TARGET("avx2") static size_t Avx2Int32(MatOp op, const int32_t* a, const int32_t* b, bool broadcast, int32_t* out, size_t n)
+{
+    if (op == MatOp::Div)
+        return 0;
+    size_t i = 0;
+    const __m256i s = _mm256_set1_epi32(*b);
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i y = broadcast ? s : _mm256_loadu_si256((const __m256i*)(b + i));
+        if (op == MatOp::Add)       x = _mm256_add_epi32(x, y);
+        else if (op == MatOp::Sub)  x = _mm256_sub_epi32(x, y);
+        else                        x = _mm256_mullo_epi32(x, y);
+        _mm256_storeu_si256((__m256i*)(out + i), x);
+    }
+    return i;
+}
+
+MAT_TARGET("avx2") static size_t Avx2UInt8(MatOp op, const uint8_t* a, const uint8_t* b, bool broadcast, uint8_t* out, size_t n)
+{
+    if (op != MatOp::Add && op != MatOp::Sub)
+        return 0;
+    size_t i = 0;
+    const __m256i s = _mm256_set1_epi8((char)*b);
+    for (; i + 32 <= n; i += 32)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i y = broadcast ? s : _mm256_loadu_si256((const __m256i*)(b + i));
+        x = op == MatOp::Add ? _mm256_adds_epu8(x, y) : _mm256_subs_epu8(x, y);
+        _mm256_storeu_si256((__m256i*)(out + i), x);
+    }
+    return i;
+}
+
+MAT_TARGET("avx2") static size_t Avx2Int16(MatOp op, const int16_t* a, const int16_t* b, bool broadcast, int16_t* out, size_t n)
+{
+    if (op != MatOp::Add && op != MatOp::Sub)
+        return 0;
+    size_t i = 0;
+    const __m256i s = _mm256_set1_epi16(*b);
+    for (; i + 16 <= n; i += 16)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i y = broadcast ? s : _mm256_loadu_si256((const __m256i*)(b + i));
+        x = op == MatOp::Add ? _mm256_adds_epi16(x, y) : _mm256_subs_epi16(x, y);
+        _mm256_storeu_si256((__m256i*)(out + i), x);
+    }
+    return i;
+}
+# pragma endregion
+
+# pragma region SSE4.1
+MAT_TARGET("sse4.1") static size_t Sse41Float(MatOp op, const float* a, const float* b, bool broadcast, float* out, size_t n)
+{
+    size_t i = 0;
+    const __m128 s = _mm_set1_ps(*b);
+    const __m128 eps = _mm_set1_ps(1e-10f);
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 x = _mm_loadu_ps(a + i);
+        __m128 y = broadcast ? s : _mm_loadu_ps(b + i);
+        switch (op)
+        {
+            case MatOp::Add: x = _mm_add_ps(x, y); break;
+            case MatOp::Sub: x = _mm_sub_ps(x, y); break;
+            case MatOp::Mul: x = _mm_mul_ps(x, y); break;
+            case MatOp::Div: x = _mm_div_ps(x, _mm_add_ps(y, eps)); break;
+        }
+        _mm_storeu_ps(out + i, x);
+    }
+    return i;
+}
+
+MAT_TARGET("sse4.1") static size_t Sse41Double(MatOp op, const double* a, const double* b, bool broadcast, double* out, size_t n)
+{
+    size_t i = 0;
+    const __m128d s = _mm_set1_pd(*b);
+    const __m128d eps = _mm_set1_pd(1e-10f);
+    for (; i + 2 <= n; i += 2)
+    {
+        __m128d x = _mm_loadu_pd(a + i);
+        __m128d y = broadcast ? s : _mm_loadu_pd(b + i);
+        switch (op)
+        {
+            case MatOp::Add: x = _mm_add_pd(x, y); break;
+            case MatOp::Sub: x = _mm_sub_pd(x, y); break;
+            case MatOp::Mul: x = _mm_mul_pd(x, y); break;
+            case MatOp::Div: x = _mm_div_pd(x, _mm_add_pd(y, eps)); break;
+        }
+        _mm_storeu_pd(out + i, x);
+    }
+    return i;
+}
+
+MAT_TARGET("sse4.1") static size_t Sse41Int32(MatOp op, const int32_t* a, const int32_t* b, bool broadcast, int32_t* out, size_t n)
+{
+    if (op == MatOp::Div)
+        return 0;
+    size_t i = 0;
+    const __m128i s = _mm_set1_epi32(*b);
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i y = broadcast ? s : _mm_loadu_si128((const __m128i*)(b + i));
+        if (op == MatOp::Add)       x = _mm_add_epi32(x, y);
+        else if (op == MatOp::Sub)  x = _mm_sub_epi32(x, y);
+        else                        x = _mm_mullo_epi32(x, y);
+        _mm_storeu_si128((__m128i*)(out + i), x);
+    }
+    return i;
+}
+
+MAT_TARGET("sse4.1") static size_t Sse41UInt8(MatOp op, const uint8_t* a, const uint8_t* b, bool broadcast, uint8_t* out, size_t n)
+{
+    if (op != MatOp::Add && op != MatOp::Sub)
+        return 0;
+    size_t i = 0;
+    const __m128i s = _mm_set1_epi8((char)*b);
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i y = broadcast ? s : _mm_loadu_si128((const __m128i*)(b + i));
+        x = op == MatOp::Add ? _mm_adds_epu8(x, y) : _mm_subs_epu8(x, y);
+        _mm_storeu_si128((__m128i*)(out + i), x);
+    }
+    return i;
+}
+
+MAT_TARGET("sse4.1") static size_t Sse41Int16(MatOp op, const int16_t* a, const int16_t* b, bool broadcast, int16_t* out, size_t n)
+{
+    if (op != MatOp::Add && op != MatOp::Sub)
+        return 0;
+    size_t i = 0;
+    const __m128i s = _mm_set1_epi16(*b);
+    for (; i + 8 <= n; i += 8)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i y = broadcast ? s : _mm_loadu_si128((const __m128i*)(b + i));
+        x = op == MatOp::Add ? _mm_adds_epi16(x, y) : _mm_subs_epi16(x, y);
+        _mm_storeu_si128((__m128i*)(out + i), x);
+    }
+    return i;
+}
+# pragma endregion
+#endif // MAT_KERNEL_X86
+
+#if MAT_KERNEL_NEON
+# pragma region NEON
+static size_t NeonFloat(MatOp op, const float* a, const float* b, bool broadcast, float* out, size_t n)
+{
+#if !defined(__aarch64__)
+    if (op == MatOp::Div)
+        return 0;   // no vector divide on armv7
+#endif
+    size_t i = 0;
+    const float32x4_t s = vdupq_n_f32(*b);
+    for (; i + 4 <= n; i += 4)
+    {
+        float32x4_t x = vld1q_f32(a + i);
+        float32x4_t y = broadcast ? s : vld1q_f32(b + i);
+        switch (op)
+        {
+            case MatOp::Add: x = vaddq_f32(x, y); break;
+            case MatOp::Sub: x = vsubq_f32(x, y); break;
+            case MatOp::Mul: x = vmulq_f32(x, y); break;
+#if defined(__aarch64__)
+            case MatOp::Div: x = vdivq_f32(x, vaddq_f32(y, vdupq_n_f32(1e-10f))); break;
+#endif
+            default: break;
+        }
+        vst1q_f32(out + i, x);
+    }
+    return i;
+}
+
+#if defined(__aarch64__)
+static size_t NeonDouble(MatOp op, const double* a, const double* b, bool broadcast, double* out, size_t n)
+{
+    size_t i = 0;
+    const float64x2_t s = vdupq_n_f64(*b);
+    for (; i + 2 <= n; i += 2)
+    {
+        float64x2_t x = vld1q_f64(a + i);
+        float64x2_t y = broadcast ? s : vld1q_f64(b + i);
+        switch (op)
+        {
+            case MatOp::Add: x = vaddq_f64(x, y); break;
+            case MatOp::Sub: x = vsubq_f64(x, y); break;
+            case MatOp::Mul: x = vmulq_f64(x, y); break;
+            case MatOp::Div: x = vdivq_f64(x, vaddq_f64(y, vdupq_n_f64(1e-10f))); break;
+        }
+        vst1q_f64(out + i, x);
+    }
+    return i;
+}
+#endif
+
+static size_t NeonInt32(MatOp op, const int32_t* a, const int32_t* b, bool broadcast, int32_t* out, size_t n)
+{
+    if (op == MatOp::Div)
+        return 0;
+    size_t i = 0;
+    const int32x4_t s = vdupq_n_s32(*b);
+    for (; i + 4 <= n; i += 4)
+    {
+        int32x4_t x = vld1q_s32(a + i);
+        int32x4_t y = broadcast ? s : vld1q_s32(b + i);
+        if (op == MatOp::Add)       x = vaddq_s32(x, y);
+        else if (op == MatOp::Sub)  x = vsubq_s32(x, y);
+        else                        x = vmulq_s32(x, y);
+        vst1q_s32(out + i, x);
+    }
+    return i;
+}
+
+static size_t NeonUInt8(MatOp op, const uint8_t* a, const uint8_t* b, bool broadcast, uint8_t* out, size_t n)
+{
+    if (op != MatOp::Add && op != MatOp::Sub)
+        return 0;
+    size_t i = 0;
+    const uint8x16_t s = vdupq_n_u8(*b);
+    for (; i + 16 <= n; i += 16)
+    {
+        uint8x16_t x = vld1q_u8(a + i);
+        uint8x16_t y = broadcast ? s : vld1q_u8(b + i);
+        x = op == MatOp::Add ? vqaddq_u8(x, y) : vqsubq_u8(x, y);
+        vst1q_u8(out + i, x);
+    }
+    return i;
+}
+
+static size_t NeonInt16(MatOp op, const int16_t* a, const int16_t* b, bool broadcast, int16_t* out, size_t n)
+{
+    if (op != MatOp::Add && op != MatOp::Sub)
+        return 0;
+    size_t i = 0;
+    const int16x8_t s = vdupq_n_s16(*b);
+    for (; i + 8 <= n; i += 8)
+    {
+        int16x8_t x = vld1q_s16(a + i);
+        int16x8_t y = broadcast ? s : vld1q_s16(b + i);
+        x = op == MatOp::Add ? vqaddq_s16(x, y) : vqsubq_s16(x, y);
+        vst1q_s16(out + i, x);
+    }
+    return i;
+}
+# pragma endregion
+#endif // MAT_KERNEL_NEON
+
+# pragma region Dispatch
+struct MatKernels
+{
+    const char*                 m_Name      {"scalar"};
+    MatVectorKernel<float>      m_Float     {nullptr};
+    MatVectorKernel<double>     m_Double    {nullptr};
+    MatVectorKernel<int32_t>    m_Int32     {nullptr};
+    MatVectorKernel<int16_t>    m_Int16     {nullptr};
+    MatVectorKernel<uint8_t>    m_UInt8     {nullptr};
+};
+
+#if MAT_KERNEL_X86
+static void DetectX86(bool& sse41, bool& avx2)
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    int count = info[0];
+    sse41 = avx2 = false;
+    if (count < 1)
+        return;
+    __cpuid(info, 1);
+    sse41 = (info[2] & (1 << 19)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (count >= 7 && osxsave && avx && (_xgetbv(0) & 6) == 6)
+    {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    sse41 = __builtin_cpu_supports("sse4.1");
+    avx2 = __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+static MatKernels SelectMatKernels()
+{
+    MatKernels kernels;
+#if MAT_KERNEL_X86
+    bool sse41 = false, avx2 = false;
+    DetectX86(sse41, avx2);
+    if (avx2)
+        kernels = { "avx2", Avx2Float, Avx2Double, Avx2Int32, Avx2Int16, Avx2UInt8 };
+    else if (sse41)
+        kernels = { "sse4.1", Sse41Float, Sse41Double, Sse41Int32, Sse41Int16, Sse41UInt8 };
+#elif MAT_KERNEL_NEON
+#if defined(__aarch64__)
+    kernels = { "neon", NeonFloat, NeonDouble, NeonInt32, NeonInt16, NeonUInt8 };
+#else
+    kernels = { "neon", NeonFloat, nullptr, NeonInt32, NeonInt16, NeonUInt8 };
+#endif
+#endif
+    return kernels;
+}
+
+static const MatKernels& GetMatKernels()
+{
+    static const MatKernels kernels = SelectMatKernels();
+    return kernels;
+}
+
+const char* MatKernelName()
+{
+    return GetMatKernels().m_Name;
+}
+
+template <typename T>
+static void MatApply(MatOp op, const T* a, const T* b, bool broadcast, T* out, size_t n, MatVectorKernel<T> vector)
+{
+    if (n == 0)
+        return;
+    size_t done = vector ? vector(op, a, b, broadcast, out, n) : 0;
+    MatScalarKernel(op, a + done, broadcast ? b : b + done, broadcast, out + done, n - done);
+}
+
+static size_t MatScalarSize(ImDataType type)
+{
+    switch (type)
+    {
+        case IM_DT_INT8:    return 1;
+        case IM_DT_INT16:   return 2;
+        case IM_DT_INT32:   return 4;
+        case IM_DT_INT64:   return 8;
+        case IM_DT_FLOAT32: return 4;
+        case IM_DT_FLOAT64: return 8;
+        default:            return 0;
+    }
+}
+
+// every element is written by the caller, so the result is only allocated, not copied from a
+static bool MatCreateResult(const ImGui::ImMat& a, ImGui::ImMat& result, size_t& count)
+{
+    auto scalarSize = MatScalarSize(a.type);
+    if (a.empty() || a.device != IM_DD_CPU || !a.data || scalarSize == 0)
+        return false;
+    result.create_like(a);
+    if (result.empty() || !result.data || result.total() * result.elemsize != a.total() * a.elemsize)
+        return false;
+    count = a.total() * a.elemsize / scalarSize;
+    return true;
+}
+
+// b is either a mat laid out like a or a single value of a's element type
+static ImGui::ImMat MatRun(MatOp op, const ImGui::ImMat& a, const void* b, bool broadcast)
+{
+    ImGui::ImMat result;
+    size_t count = 0;
+    if (!MatCreateResult(a, result, count))
+        return {};
+    auto& kernels = GetMatKernels();
+    switch (a.type)
+    {
+        case IM_DT_INT8:    MatApply(op, (const uint8_t*)a.data, (const uint8_t*)b, broadcast, (uint8_t*)result.data, count, kernels.m_UInt8); break;
+        case IM_DT_INT16:   MatApply(op, (const int16_t*)a.data, (const int16_t*)b, broadcast, (int16_t*)result.data, count, kernels.m_Int16); break;
+        case IM_DT_INT32:   MatApply(op, (const int32_t*)a.data, (const int32_t*)b, broadcast, (int32_t*)result.data, count, kernels.m_Int32); break;
+        case IM_DT_INT64:   MatApply<int64_t>(op, (const int64_t*)a.data, (const int64_t*)b, broadcast, (int64_t*)result.data, count, nullptr); break;
+        case IM_DT_FLOAT32: MatApply(op, (const float*)a.data, (const float*)b, broadcast, (float*)result.data, count, kernels.m_Float); break;
+        case IM_DT_FLOAT64: MatApply(op, (const double*)a.data, (const double*)b, broadcast, (double*)result.data, count, kernels.m_Double); break;
+        default:            return {};
+    }
+    return result;
+}
+
+static ImGui::ImMat MatRunWide(MatOp op, const ImGui::ImMat& a, double b)
+{
+    ImGui::ImMat result;
+    size_t count = 0;
+    if (!MatCreateResult(a, result, count))
+        return {};
+    switch (a.type)
+    {
+        case IM_DT_INT8:    MatWideKernel(op, (const uint8_t*)a.data, b, (uint8_t*)result.data, count); break;
+        case IM_DT_INT16:   MatWideKernel(op, (const int16_t*)a.data, b, (int16_t*)result.data, count); break;
+        case IM_DT_INT32:   MatWideKernel(op, (const int32_t*)a.data, b, (int32_t*)result.data, count); break;
+        case IM_DT_INT64:   MatWideKernel(op, (const int64_t*)a.data, b, (int64_t*)result.data, count); break;
+        default:            return {};
+    }
+    return result;
+}
+
+static bool MatSameLayout(const ImGui::ImMat& a, const ImGui::ImMat& b)
+{
+    return a.w == b.w && a.h == b.h && a.c == b.c && a.type == b.type &&
+           a.elemsize == b.elemsize && a.elempack == b.elempack && a.cstep == b.cstep &&
+           b.device == IM_DD_CPU && b.data;
+}
+# pragma endregion
+
+ImGui::ImMat MatBinary(MatOp op, const ImGui::ImMat& a, const ImGui::ImMat& b)
+{
+    if (!MatSameLayout(a, b))
+        return {};
+    return MatRun(op, a, b.data, false);
+}
+
+ImGui::ImMat MatBinary(MatOp op, const ImGui::ImMat& a, double b)
+{
+    if (!IsElementValue(a.type, b))
+        return MatRunWide(op, a, b);
+    // one element of a's type is enough, the kernels broadcast it
+    union
+    {
+        uint8_t u8;
+        int16_t i16;
+        int32_t i32;
+        int64_t i64;
+        float   f32;
+        double  f64;
+    } value;
+    switch (a.type)
+    {
+        case IM_DT_INT8:    value.u8  = MatScalar<uint8_t>::FromDouble(b); break;
+        case IM_DT_INT16:   value.i16 = MatScalar<int16_t>::FromDouble(b); break;
+        case IM_DT_INT32:   value.i32 = MatScalar<int32_t>::FromDouble(b); break;
+        case IM_DT_INT64:   value.i64 = MatScalar<int64_t>::FromDouble(b); break;
+        case IM_DT_FLOAT32: value.f32 = MatScalar<float>::FromDouble(b); break;
+        case IM_DT_FLOAT64: value.f64 = b; break;
+        default:            return {};
+    }
+    return MatRun(op, a, &value, true);
+}
+
+template <typename T>
+static int32_t MatCompareElements(const T* a, const T* b, size_t n)
+{
+    // memcmp finds the differing block quickly, the order is decided on elements
+    const size_t block = 64;
+    for (size_t i = 0; i < n; i += block)
+    {
+        auto count = std::min(block, n - i);
+        if (memcmp(a + i, b + i, count * sizeof(T)) == 0)
+            continue;
+        for (size_t j = i; j < i + count; j++)
+        {
+            if (a[j] != b[j])
+                return a[j] > b[j] ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
+bool MatCompare(const ImGui::ImMat& a, const ImGui::ImMat& b, int32_t& result)
+{
+    auto scalarSize = MatScalarSize(a.type);
+    if (a.empty() || a.device != IM_DD_CPU || !a.data || scalarSize == 0 || !MatSameLayout(a, b))
+        return false;
+    auto count = a.total() * a.elemsize / scalarSize;
+    switch (a.type)
+    {
+        case IM_DT_INT8:    result = MatCompareElements((const uint8_t*)a.data, (const uint8_t*)b.data, count); break;
+        case IM_DT_INT16:   result = MatCompareElements((const int16_t*)a.data, (const int16_t*)b.data, count); break;
+        case IM_DT_INT32:   result = MatCompareElements((const int32_t*)a.data, (const int32_t*)b.data, count); break;
+        case IM_DT_INT64:   result = MatCompareElements((const int64_t*)a.data, (const int64_t*)b.data, count); break;
+        case IM_DT_FLOAT32: result = MatCompareElements((const float*)a.data, (const float*)b.data, count); break;
+        case IM_DT_FLOAT64: result = MatCompareElements((const double*)a.data, (const double*)b.data, count); break;
+        default:            return false;
+    }
+    return true;
+}
+} // namespace BluePrint
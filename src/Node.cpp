@@ -125,6 +125,9 @@ NodeRegistry::NodeRegistry()
         BranchNode::GetStaticTypeInfo(),
         FlipFlopNode::GetStaticTypeInfo(),
         PrintNode::GetStaticTypeInfo(),
+        ParallelNode::GetStaticTypeInfo(),
+        ParallelForNode::GetStaticTypeInfo(),
+        JoinNode::GetStaticTypeInfo(),
     })
 {
     RebuildTypes();
@@ -170,6 +173,11 @@ ID_TYPE NodeRegistry::RegisterNodeType(shared_ptr<NodeTypeInfo> info)
     typeInfo.m_Catalog          = info->m_Catalog;
     typeInfo.m_Factory          = info->m_Factory;
     typeInfo.m_Url              = info->m_Url;
+    if (info->m_API_Version >= NODE_FLAGS_API_VERSION)
+    {
+        typeInfo.m_Flags        = info->m_Flags;
+        typeInfo.m_Cost         = info->m_Cost;
+    }
 
     m_CustomNodes.push_back(std::move(typeInfo));
 
@@ -281,7 +289,10 @@ Node* NodeRegistry::Create(ID_TYPE typeId, BP* blueprint)
         if (nodeInfo->m_ID != typeId)
             continue;
 
-        return nodeInfo->m_Factory(blueprint);
+        auto node = nodeInfo->m_Factory(blueprint);
+        if (node)
+            node->PinsChanged();
+        return node;
     }
 
     return nullptr;
@@ -294,7 +305,10 @@ Node* NodeRegistry::Create(std::string typeName, BP* blueprint)
         if (nodeInfo->m_Name != typeName)
             continue;
 
-        return nodeInfo->m_Factory(blueprint);
+        auto node = nodeInfo->m_Factory(blueprint);
+        if (node)
+            node->PinsChanged();
+        return node;
     }
 
     return nullptr;
@@ -335,14 +349,42 @@ const NodeTypeInfo* NodeRegistry::GetTypeInfo(ID_TYPE typeId) const
 // -------[ Node ]-------
 // ----------------------
 
+void Node::Reset(Context& context)
+{
+    auto& state = context.GetNodeState(*this);
+    state.m_Tick = 0;
+    state.m_Hits = 0;
+    state.m_NodeTimeMs = 0;
+    if (!context.m_Shared)
+    {
+        m_Tick = 0;
+        m_Hits = 0;
+        m_NodeTimeMs = 0;
+    }
+}
+
 Node::Node(BP* blueprint)
     : m_Blueprint(blueprint)
 {
     if (blueprint) m_ID = blueprint->MakeNodeID(this);
 }
 
+void Node::PinsChanged()
+{
+    // sides are written here only, IsInput/IsOutput and friends just read them back
+    for (auto pin : GetInputPins())
+        pin->m_Flags &= ~PIN_FLAG_SIDE_MASK;
+    for (auto pin : GetOutputPins())
+        pin->m_Flags &= ~PIN_FLAG_SIDE_MASK;
+    for (auto pin : GetInputPins())
+        pin->m_Flags |= PIN_FLAG_SIDE_KNOWN | PIN_FLAG_INPUT_SIDE;
+    for (auto pin : GetOutputPins())
+        pin->m_Flags |= PIN_FLAG_SIDE_KNOWN | PIN_FLAG_OUTPUT_SIDE;
+}
+
 unique_ptr<Pin> Node::CreatePin(PinType pinType, std::string name)
 {
+    ArenaScope scope(m_Blueprint ? m_Blueprint->GetArena() : nullptr);
     switch (pinType)
     {
         default:
@@ -358,6 +400,8 @@ unique_ptr<Pin> Node::CreatePin(PinType pinType, std::string name)
         case PinType::Point:    return make_unique<PointPin>(this, name);
         case PinType::Vec2:     return make_unique<Vec2Pin>(this, name);
         case PinType::Vec4:     return make_unique<Vec4Pin>(this, name);
+        case PinType::Mat:      return make_unique<MatPin>(this, name);
+        case PinType::Array:    return make_unique<ArrayPin>(this, name);
     }
 
     return nullptr;
@@ -365,6 +409,7 @@ unique_ptr<Pin> Node::CreatePin(PinType pinType, std::string name)
 
 Pin * Node::NewPin(PinType pinType, std::string name)
 {
+    ArenaScope scope(m_Blueprint ? m_Blueprint->GetArena() : nullptr);
     Pin * pin = nullptr;
     switch (pinType)
     {
@@ -431,6 +476,16 @@ std::string Node::GetCatalog() const
     return GetTypeInfo().m_Catalog;
 }
 
+uint32_t Node::GetFlags() const
+{
+    return GetTypeInfo().m_Flags;
+}
+
+NodeCost Node::GetCost() const
+{
+    return GetTypeInfo().m_Cost;
+}
+
 std::string Node::GetURL() const
 {
     ID_TYPE id = GetTypeInfo().m_ID;
@@ -592,32 +647,10 @@ LinkQueryResult Node::AcceptLink(const Pin& receiver, const Pin& provider)
     if (provider.GetValueType() != receiver.GetValueType() && (provider.GetType() != PinType::Any && receiver.GetType() != PinType::Any))
         return { false, "Incompatible types"};
 
-    if (receiverIsFlow && providerIsFlow)
+    if (receiverIsFlow && providerIsFlow && m_Blueprint)
     {
         // Check loop for flow pin
-        auto check_loop = [](auto&& self, Node* node, ID_TYPE id)
-        {
-            auto pins = node->GetOutputPins();
-            for (auto pin : pins)
-            {
-                if (pin->GetType() != PinType::Flow)
-                    continue;
-                auto link_pin = pin->GetLink();
-                if (!link_pin)
-                    continue;
-                if (link_pin->m_Node->m_ID == id)
-                {
-                    return true;
-                }
-                if (self(self, link_pin->m_Node, id))
-                {
-                    return true;
-                }
-            }
-            return false;
-        };
-        
-        if (check_loop(check_loop, provider.m_Node, m_ID))
+        if (m_Blueprint->FlowReaches(*provider.m_Node, *this))
         {
             return { false, "Flow found dead loop"};
         }
@@ -641,6 +674,7 @@ int Node::Load(const imgui_json::value& value)
 
     if (!imgui_json::GetTo<imgui_json::number>(value, "id", m_ID)) // required
         return BP_ERR_NODE_LOAD;
+    if (m_Blueprint) m_Blueprint->InvalidateIndex();
 
     if (!imgui_json::GetTo<imgui_json::string>(value, "name", m_Name)) // required
         return BP_ERR_NODE_LOAD;
@@ -752,7 +786,7 @@ void Node::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID)
         pin->Save(pinValue, MapID);
         if (isRemap && (pin->m_Flags & PIN_FLAG_EXPORTED))
         {
-            auto new_flags = pin->m_Flags;
+            auto new_flags = pin->m_Flags & ~PIN_FLAG_SIDE_MASK;
             new_flags &= ~PIN_FLAG_EXPORTED;
             new_flags |= PIN_FLAG_PUBLICIZED;
             pinValue["flags"] = imgui_json::number(new_flags);
@@ -769,7 +803,7 @@ void Node::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID)
         pin->Save(pinValue, MapID);
         if (isRemap && (pin->m_Flags & PIN_FLAG_EXPORTED))
         {
-            auto new_flags = pin->m_Flags;
+            auto new_flags = pin->m_Flags & ~PIN_FLAG_SIDE_MASK;
             new_flags &= ~PIN_FLAG_EXPORTED;
             new_flags |= PIN_FLAG_PUBLICIZED;
             pinValue["flags"] = imgui_json::number(new_flags);
@@ -80,12 +80,13 @@ Pin::Pin(Node* node, PinType type, std::string name)
     if (node && node->m_Blueprint)
     {
         m_ID = node->m_Blueprint->MakePinID(this);
+        m_Registration.m_Set = true;
     }
 }
 
 Pin::~Pin()
 {
-    if (m_Node && m_Node->m_ID && m_Node->m_Blueprint)
+    if (m_Registration.m_Set && m_Node && m_Node->m_ID && m_Node->m_Blueprint)
         m_Node->m_Blueprint->ForgetPin(this);
 }
 
@@ -119,6 +120,8 @@ bool Pin::LinkTo(Pin& pin)
         Unlink();
 
     m_Link = pin.m_ID;
+    if (m_Node->m_Blueprint)
+        m_Node->m_Blueprint->OnPinLinked(*this, m_Link);
 
     m_Node->WasLinked(*this, pin);
     pin.m_Node->WasLinked(*this, pin);
@@ -129,6 +132,8 @@ bool Pin::LinkTo(Pin& pin)
     {
         pin.m_LinkFrom.push_back(m_ID);
     }
+    if (m_Node->m_Blueprint)
+        m_Node->m_Blueprint->InvalidatePlan();
     ed::SetPinChanged(pin.m_ID);
 
     return true;
@@ -144,6 +149,7 @@ void Pin::Unlink()
     if (!link)
         return;
 
+    bp->OnPinUnlinked(*this, m_Link);
     m_Link = 0;
 
     m_Node->WasUnlinked(*this, *link);
@@ -167,6 +173,7 @@ void Pin::Unlink()
         link->m_Flags &= ~PIN_FLAG_LINKED;
     }
 
+    bp->InvalidatePlan();
     ed::SetLinkChanged(link->m_ID);
 }
 
@@ -189,46 +196,24 @@ Pin* Pin::GetLink(const BP *bp) const
 
 bool Pin::IsInput() const
 {
-    for (auto pin : m_Node->GetInputPins())
-        if (pin->m_ID == m_ID)
-            return true;
-
-    return false;
+    return SideFlags() & PIN_FLAG_INPUT_SIDE;
 }
 
 bool Pin::IsOutput() const
 {
-    for (auto pin : m_Node->GetOutputPins())
-        if (pin->m_ID == m_ID)
-            return true;
-
-    return false;
+    return SideFlags() & PIN_FLAG_OUTPUT_SIDE;
 }
 
 bool Pin::IsProvider() const
 {
     auto outputToInput = (GetValueType() != PinType::Flow);
-
-    auto pins = outputToInput ? m_Node->GetOutputPins() : m_Node->GetInputPins();
-
-    for (auto pin : pins)
-        if (pin->m_ID == m_ID)
-            return true;
-
-    return false;
+    return SideFlags() & (outputToInput ? PIN_FLAG_OUTPUT_SIDE : PIN_FLAG_INPUT_SIDE);
 }
 
 bool Pin::IsReceiver() const
 {
     auto outputToInput = (GetValueType() != PinType::Flow);
-
-    auto pins = outputToInput ? m_Node->GetInputPins() : m_Node->GetOutputPins();
-
-    for (auto pin : pins)
-        if (pin->m_ID == m_ID)
-            return true;
-
-    return false;
+    return SideFlags() & (outputToInput ? PIN_FLAG_INPUT_SIDE : PIN_FLAG_OUTPUT_SIDE);
 }
 
 bool Pin::IsMappedPin() const
@@ -262,6 +247,9 @@ bool Pin::Load(const imgui_json::value& value)
 
     if (!imgui_json::GetTo<imgui_json::number>(value, "id", m_ID)) // required
         return false;
+    // id and link are set directly
+    if (m_Node && m_Node->m_Blueprint)
+        m_Node->m_Blueprint->InvalidateIndex();
 
     if (value.contains("link"))
         imgui_json::GetTo<imgui_json::number>(value, "link", m_Link); // optional
@@ -270,7 +258,12 @@ bool Pin::Load(const imgui_json::value& value)
         imgui_json::GetTo<imgui_json::number>(value, "map", m_MappedPin); // optional
     
     if (value.contains("flags"))
+    {
+        // the side comes from the node's pin lists, not from the file
+        auto side = m_Flags & PIN_FLAG_SIDE_MASK;
         imgui_json::GetTo<imgui_json::number>(value, "flags", m_Flags); // optional
+        m_Flags = (m_Flags & ~PIN_FLAG_SIDE_MASK) | side;
+    }
 
     if (value.contains("name"))
         imgui_json::GetTo<imgui_json::string>(value, "name", m_Name);
@@ -296,7 +289,7 @@ void Pin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
     value["type"] = PinTypeToString(m_Type);
     if (m_Link) value["link"] = imgui_json::number(GetIDFromMap(m_Link, MapID));
     value["map"] = imgui_json::number(GetIDFromMap(m_MappedPin, MapID));
-    value["flags"] = imgui_json::number(m_Flags);
+    value["flags"] = imgui_json::number(m_Flags & ~PIN_FLAG_SIDE_MASK);
     if (!m_Name.empty())
         value["name"] = m_Name;  // optional, to make data readable for humans
     auto& LinkFromPinsValue = value["link_from"]; // optional
@@ -0,0 +1,135 @@
+#include <TimerWheel.h>
+#include <algorithm>
+
+namespace BluePrint
+{
+static inline uint64_t LevelSpan(int level)
+{
+    return uint64_t(1) << (TimerWheel::SLOT_BITS * level);
+}
+
+TimerWheel::TimerWheel(Clock::duration tick)
+    : m_Origin(Clock::now())
+    , m_Tick(tick > Clock::duration::zero() ? tick : std::chrono::milliseconds(1))
+{
+}
+
+uint64_t TimerWheel::ToTick(Clock::time_point time) const
+{
+    if (time <= m_Origin)
+        return 0;
+    // rounded up, a timer never fires before its deadline
+    auto elapsed = time - m_Origin;
+    return static_cast<uint64_t>((elapsed + m_Tick - Clock::duration(1)) / m_Tick);
+}
+
+TimerWheel::Clock::time_point TimerWheel::ToTime(uint64_t tick) const
+{
+    return m_Origin + m_Tick * static_cast<Clock::rep>(tick);
+}
+
+void TimerWheel::Add(Clock::time_point time, Callback callback)
+{
+    m_Count++;
+    Place({ToTick(time), std::move(callback)});
+}
+
+void TimerWheel::Place(Timer&& timer)
+{
+    if (timer.m_Tick <= m_Current)
+    {
+        m_Due.push_back(std::move(timer));
+        return;
+    }
+    auto delta = timer.m_Tick - m_Current;
+    for (int level = 0; level < LEVELS; level++)
+    {
+        if (delta < LevelSpan(level + 1))
+        {
+            auto slot = (timer.m_Tick >> (SLOT_BITS * level)) & (SLOTS - 1);
+            m_Slots[level][slot].push_back(std::move(timer));
+            return;
+        }
+    }
+    m_Overflow.push_back(std::move(timer));
+}
+
+void TimerWheel::Cascade(int level)
+{
+    auto slot = (m_Current >> (SLOT_BITS * level)) & (SLOTS - 1);
+    auto timers = std::move(m_Slots[level][slot]);
+    m_Slots[level][slot].clear();
+    for (auto& timer : timers)
+        Place(std::move(timer));
+}
+
+void TimerWheel::Advance(Clock::time_point now, std::vector<Callback>& expired)
+{
+    auto target = ToTick(now);
+    if (target > 0 && now < ToTime(target))
+        target--;   // the tick now lies in has not ended yet
+    if (m_Count == m_Due.size() && target > m_Current)
+        m_Current = target;     // nothing on the wheel, no need to turn it tick by tick
+
+    auto collect = [&](std::vector<Timer>& timers)
+    {
+        for (auto& timer : timers)
+            expired.push_back(std::move(timer.m_Callback));
+        m_Count -= timers.size();
+        timers.clear();
+    };
+    collect(m_Due);
+
+    while (m_Current < target)
+    {
+        m_Current++;
+        // a wrap of one level pulls the next slot of the level above down, top level first
+        int top = 0;
+        while (top + 1 < LEVELS && (m_Current & (LevelSpan(top + 1) - 1)) == 0)
+            top++;
+        if (top == LEVELS - 1 && (m_Current & (LevelSpan(LEVELS) - 1)) == 0)
+        {
+            auto timers = std::move(m_Overflow);
+            m_Overflow.clear();
+            for (auto& timer : timers)
+                Place(std::move(timer));
+        }
+        for (int level = top; level > 0; level--)
+            Cascade(level);
+
+        collect(m_Slots[0][m_Current & (SLOTS - 1)]);
+        collect(m_Due);
+        if (m_Count == 0)
+        {
+            m_Current = target;
+            break;
+        }
+    }
+}
+
+TimerWheel::Clock::time_point TimerWheel::NextExpiry() const
+{
+    if (m_Count == 0)
+        return Clock::time_point::max();
+    if (!m_Due.empty())
+        return Clock::now();
+
+    // level 0 holds exact ticks, higher levels give the tick their slot cascades at, which is never later
+    uint64_t next = UINT64_MAX;
+    for (int level = 0; level < LEVELS; level++)
+    {
+        auto base = m_Current >> (SLOT_BITS * level);
+        for (uint64_t i = 1; i <= SLOTS; i++)
+        {
+            if (!m_Slots[level][(base + i) & (SLOTS - 1)].empty())
+            {
+                next = std::min(next, (base + i) << (SLOT_BITS * level));
+                break;
+            }
+        }
+    }
+    if (!m_Overflow.empty())
+        next = std::min(next, ((m_Current >> (SLOT_BITS * LEVELS)) + 1) << (SLOT_BITS * LEVELS));
+    return ToTime(next);
+}
+} // namespace BluePrint
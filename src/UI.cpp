@@ -7,7 +7,6 @@
 #define THUMBNAIL_HIDDEN    30
 #define DEBUG_NODE_DRAWING  0
 #define DEBUG_GROUP_NODE    0
-extern std::mutex g_Mutex;
 
 inline string to_lower(string s) 
 {        
@@ -307,6 +306,7 @@ void NodeSettingDialog::Show(BluePrintUI& UI)
             {
                 UI.File_MarkModified();
                 ed::SetNodeChanged(node->m_ID);
+                UI.m_Document->m_Blueprint.MarkDirty(node);
             }
             ImGui::CloseCurrentPopup();
             if (UI.m_CallBacks.BluePrintOnChanged)
@@ -1117,6 +1117,7 @@ float BluePrintUI::DrawNodeToolBar(Node *node, Node **need_clone_node)
             if (node->m_Enabled) LOGI("[HandleNodeToolBar] Enable for %" PRI_node, FMT_node(node));
             else                 LOGI("[HandleNodeToolBar] Disable for %" PRI_node, FMT_node(node));
             ed::SetNodeChanged(node->m_ID);
+            m_Document->m_Blueprint.MarkDirty(node);
             if (m_CallBacks.BluePrintOnChanged)
             {
                 m_CallBacks.BluePrintOnChanged(BP_CB_PARAM_CHANGED, m_Document->m_Name, m_UserHandle);
@@ -1206,12 +1207,6 @@ void BluePrintUI::CommitLinksToEditor()
             continue;
         }
 
-        if (std::find(pins.begin(), pins.end(), link) == pins.end())
-        {
-            pin->m_Link = 0;
-            continue;
-        }
-        
         // To keep things simple, link id is same as pin id.
         // check link is between bridge and shadow
         //bool inner_link = pin->IsMappedPin() && link->IsMappedPin() && pin->m_MappedPin && pin->m_MappedPin == link->m_MappedPin;
@@ -1822,11 +1817,10 @@ void BluePrintUI::DrawNodes()
     bool isThreadPaused = m_Document->m_Blueprint.IsPaused();
     if (isThreadExecuting && !isThreadPaused && m_DebugOverlay && !m_isChildWindow)
     {
-        g_Mutex.lock();
+        std::lock_guard<std::mutex> lock(m_Document->m_Blueprint.GetContext().MonitorMutex());
         m_Document->m_Blueprint.SetContextMonitor(m_DebugOverlay->GetContextMonitor());
         m_Document->m_Blueprint.ShowFlow();
         m_Document->m_Blueprint.SetContextMonitor(nullptr);
-        g_Mutex.unlock();
     }
 
     // Handle new node menu last line drawing
@@ -3618,6 +3612,7 @@ bool BluePrintUI::Blueprint_SetFilter(const std::string name, const PinValue& va
     FloatPin * pin = (FloatPin * )entryNode->FindPin(name);
     if (pin)
     {
+        m_Document->m_Blueprint.MarkDirty(entryNode);
         return pin->SetValue(value);
     }
     return false;
@@ -3663,6 +3658,7 @@ bool BluePrintUI::Blueprint_SetTransition(const std::string name, const PinValue
     FloatPin * pin = (FloatPin * )entryNode->FindPin(name);
     if (pin)
     {
+        m_Document->m_Blueprint.MarkDirty(entryNode);
         return pin->SetValue(value);
     }
     return false;
@@ -4614,6 +4610,7 @@ void BluePrintUI::ShowSettingPanel(bool* show)
                 {
                     File_MarkModified();
                     ed::SetNodeChanged(node->m_ID);
+                    m_Document->m_Blueprint.MarkDirty(node);
                     if (m_CallBacks.BluePrintOnChanged)
                     {
                         m_CallBacks.BluePrintOnChanged(BP_CB_SETTING_CHANGED, m_Document->m_Name, m_UserHandle);
@@ -0,0 +1,65 @@
+#include <Arena.h>
+#include <memory>
+#include "UnitTest.h"
+
+using namespace BluePrint;
+
+struct Block
+{
+    BP_ARENA_ALLOCATED
+
+    int m_Value {0};
+};
+
+static void ReleaseWhenEmpty()
+{
+    Arena arena;
+    Block* block = nullptr;
+    {
+        ArenaScope scope(&arena);
+        block = new Block();
+    }
+    BP_CHECK(arena.Live() == 1 && arena.Capacity() != 0);
+    BP_CHECK(!arena.Release());
+    delete block;
+    BP_CHECK(arena.Live() == 0);
+    BP_CHECK(arena.Release());
+    BP_CHECK(arena.Capacity() == 0);
+}
+
+// a dropped arena stays until its last object is deleted, then frees itself
+static void DropWithLiveObjects()
+{
+    std::unique_ptr<Arena, Arena::Dropper> arena(new Arena());
+    Block* first = nullptr;
+    Block* second = nullptr;
+    {
+        ArenaScope scope(arena.get());
+        first = new Block();
+        second = new Block();
+    }
+    BP_CHECK(!arena->Release());
+    arena.reset();
+
+    // still readable after the drop, the leak checker reports the chunks if the last delete keeps them
+    first->m_Value = 1;
+    second->m_Value = 2;
+    BP_CHECK(first->m_Value + second->m_Value == 3);
+    delete first;
+    delete second;
+}
+
+static void HeapWithoutScope()
+{
+    auto block = new Block();
+    BP_CHECK(Arena::Current() == nullptr);
+    delete block;
+}
+
+int main()
+{
+    BP_RUN_TEST(ReleaseWhenEmpty);
+    BP_RUN_TEST(DropWithLiveObjects);
+    BP_RUN_TEST(HeapWithoutScope);
+    return BP_TEST_RESULT();
+}
@@ -0,0 +1,163 @@
+#include <MatKernel.h>
+#include "TestBlueprint.h"
+#include "UnitTest.h"
+
+using namespace BluePrint;
+
+namespace BluePrint
+{
+// Data only node, outputs the values the test puts in its pins
+struct SourceNode final : Node
+{
+    BP_NODE(SourceNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Default, "Test", NODE_FLAG_THREAD_SAFE | NODE_FLAG_DETERMINISTIC)
+
+    SourceNode(BP* blueprint): Node(blueprint) { m_Name = "Source"; }
+
+    span<Pin*> GetOutputPins() override { return m_OutputPins; }
+
+    Int32Pin m_Int = { this, "Int" };
+    MatPin   m_Mat = { this, "Mat" };
+
+    Pin* m_OutputPins[2] = { &m_Int, &m_Mat };
+};
+} // namespace BluePrint
+
+// the AddNode helper of TestBlueprint.h hides the node type of the same name
+using AdditionNode = struct BluePrint::AddNode;
+
+static ImGui::ImMat MakeMat()
+{
+    ImGui::ImMat mat;
+    mat.create_type(4, 1, 1, IM_DT_INT8);
+    auto data = static_cast<uint8_t*>(mat.data);
+    for (int i = 0; i < 4; i++)
+        data[i] = uint8_t(i * 10);
+    return mat;
+}
+
+// A + B with B a scalar adds it to every element
+static void CheckBroadcastSum(const BP& blueprint, const AdditionNode& add)
+{
+    auto result = blueprint.GetContext().GetPinValue(add.m_Result);
+    BP_CHECK(result.GetType() == PinType::Mat);
+    if (result.GetType() != PinType::Mat)
+        return;
+    auto& mat = result.As<ImGui::ImMat>();
+    BP_CHECK(mat.w == 4 && mat.type == IM_DT_INT8);
+    auto data = static_cast<const uint8_t*>(mat.data);
+    for (int i = 0; i < 4 && mat.w == 4; i++)
+        BP_CHECK(data[i] == i * 10 + 5);
+}
+
+// the node turning Mat after B was linked to a scalar keeps that link
+static void ScalarBLinkedFirst()
+{
+    HeadlessEditor editor;
+    BP blueprint;
+    auto source = AddNode<SourceNode>(blueprint);
+    auto add = AddNode<AdditionNode>(blueprint);
+    source->m_Int.m_Value = 5;
+    source->m_Mat.m_Value = MakeMat();
+
+    BP_CHECK(add->m_B.LinkTo(source->m_Int));
+    BP_CHECK(add->m_Type == PinType::Int32);
+    BP_CHECK(add->m_A.LinkTo(source->m_Mat));
+    BP_CHECK(add->m_Type == PinType::Mat);
+    BP_CHECK(add->m_A.GetLink() == &source->m_Mat);
+    BP_CHECK(add->m_B.GetLink() == &source->m_Int);
+    CheckBroadcastSum(blueprint, *add);
+}
+
+static void MatALinkedFirst()
+{
+    HeadlessEditor editor;
+    BP blueprint;
+    auto source = AddNode<SourceNode>(blueprint);
+    auto add = AddNode<AdditionNode>(blueprint);
+    source->m_Int.m_Value = 5;
+    source->m_Mat.m_Value = MakeMat();
+
+    BP_CHECK(add->m_A.LinkTo(source->m_Mat));
+    BP_CHECK(add->m_B.LinkTo(source->m_Int));
+    BP_CHECK(add->m_Type == PinType::Mat);
+    BP_CHECK(add->m_B.GetLink() == &source->m_Int);
+    CheckBroadcastSum(blueprint, *add);
+}
+
+static bool MatEquals(const ImGui::ImMat& mat, std::initializer_list<int> expected)
+{
+    if (mat.empty() || mat.type != IM_DT_INT8 || mat.w != (int)expected.size())
+        return false;
+    auto data = static_cast<const uint8_t*>(mat.data);
+    for (auto value : expected)
+    {
+        if (*data++ != value)
+            return false;
+    }
+    return true;
+}
+
+// a scalar that is no uint8 value is applied in wide math, only the result saturates
+static void BroadcastUsesWideMath()
+{
+    auto mat = MakeMat();
+    BP_CHECK(MatEquals(MatBinary(MatOp::Mul, mat, 0.5), { 0, 5, 10, 15 }));
+    BP_CHECK(MatEquals(MatBinary(MatOp::Add, mat, -10.0), { 0, 0, 10, 20 }));
+    BP_CHECK(MatEquals(MatBinary(MatOp::Sub, mat, -10.0), { 10, 20, 30, 40 }));
+    BP_CHECK(MatEquals(MatBinary(MatOp::Div, mat, 0.5), { 0, 20, 40, 60 }));
+    BP_CHECK(MatEquals(MatBinary(MatOp::Mul, mat, 300.0), { 0, 255, 255, 255 }));
+    BP_CHECK(MatEquals(MatBinary(MatOp::Add, mat, 5.0), { 5, 15, 25, 35 }));
+}
+
+// two Mat sums feeding a third are heavy independent subtrees, the plan evaluates them together
+static void MatInputsArePrefetched()
+{
+    HeadlessEditor editor;
+    BP blueprint;
+    auto left = AddNode<SourceNode>(blueprint);
+    auto right = AddNode<SourceNode>(blueprint);
+    auto addLeft = AddNode<AdditionNode>(blueprint);
+    auto addRight = AddNode<AdditionNode>(blueprint);
+    auto sum = AddNode<AdditionNode>(blueprint);
+    for (auto source : { left, right })
+    {
+        source->m_Int.m_Value = 5;
+        source->m_Mat.m_Value = MakeMat();
+    }
+    BP_CHECK(addLeft->m_A.LinkTo(left->m_Mat) && addLeft->m_B.LinkTo(left->m_Int));
+    BP_CHECK(addRight->m_A.LinkTo(right->m_Mat) && addRight->m_B.LinkTo(right->m_Int));
+    BP_CHECK(sum->m_A.LinkTo(addLeft->m_Result) && sum->m_B.LinkTo(addRight->m_Result));
+    BP_CHECK(sum->GetCost() == NodeCost::Heavy);
+
+    blueprint.Compile();
+    auto inputs = blueprint.GetExecutionPlan().FindParallelInputs(*sum);
+    BP_CHECK(inputs && inputs->size() == 2);
+    auto result = blueprint.GetContext().GetPinValue(sum->m_Result);
+    BP_CHECK(result.GetType() == PinType::Mat);
+    if (result.GetType() == PinType::Mat)
+    {
+        auto data = static_cast<const uint8_t*>(result.As<ImGui::ImMat>().data);
+        for (int i = 0; i < 4; i++)
+            BP_CHECK(data[i] == (i * 10 + 5) * 2);
+    }
+
+    // scalar sums are not worth a task
+    auto scalar = AddNode<AdditionNode>(blueprint);
+    auto scalarLeft = AddNode<AdditionNode>(blueprint);
+    auto scalarRight = AddNode<AdditionNode>(blueprint);
+    BP_CHECK(scalarLeft->m_A.LinkTo(left->m_Int) && scalarRight->m_A.LinkTo(right->m_Int));
+    BP_CHECK(scalar->m_A.LinkTo(scalarLeft->m_Result) && scalar->m_B.LinkTo(scalarRight->m_Result));
+    BP_CHECK(scalar->GetCost() == NodeCost::Trivial);
+    blueprint.Compile();
+    BP_CHECK(blueprint.GetExecutionPlan().FindParallelInputs(*scalar) == nullptr);
+    BP_CHECK(blueprint.GetExecutionPlan().FindParallelInputs(*sum) != nullptr);
+}
+
+int main()
+{
+    BP_RUN_TEST(ScalarBLinkedFirst);
+    BP_RUN_TEST(MatALinkedFirst);
+    BP_RUN_TEST(BroadcastUsesWideMath);
+    BP_RUN_TEST(MatInputsArePrefetched);
+    return BP_TEST_RESULT();
+}
@@ -0,0 +1,167 @@
+#include <BinaryFormat.h>
+#include <Document.h>
+#include <stdio.h>
+#include <vector>
+#include "TestBlueprint.h"
+#include "UnitTest.h"
+
+using namespace BluePrint;
+
+static const char* s_BinaryPath = "BinaryFormatTest.bpb";
+
+static imgui_json::value Nested(int depth)
+{
+    imgui_json::value value(imgui_json::number(1));
+    for (int i = 0; i < depth; i++)
+        value = imgui_json::value(imgui_json::array{ value });
+    return value;
+}
+
+// every json type, empty containers and non ascii text come back as they were
+static void JsonRoundTrip()
+{
+    imgui_json::object pin
+    {
+        { "id", imgui_json::number(9) },
+        { "name", "Out" },
+        { "flag", imgui_json::boolean(true) },
+        { "none", imgui_json::value() },
+    };
+    imgui_json::object node
+    {
+        { "id", imgui_json::number(1) },
+        { "type_id", imgui_json::number(0x1234) },
+        { "name", "Entry" },
+        { "output_pins", imgui_json::array{ imgui_json::value(pin) } },
+        { "empty_array", imgui_json::array{} },
+        { "empty_object", imgui_json::object{} },
+    };
+    imgui_json::value root(imgui_json::object
+    {
+        { "nodes", imgui_json::array{ imgui_json::value(node), imgui_json::value(node) } },
+        { "numbers", imgui_json::array{ imgui_json::number(-2.25e100), imgui_json::number(0.5) } },
+        { "text", "\xc3\xbc" },
+    });
+
+    BP_CHECK(BinaryDocument::Save(root, s_BinaryPath));
+    BP_CHECK(BinaryDocument::IsBinaryFile(s_BinaryPath));
+    BinaryDocument document;
+    BP_CHECK(document.Open(s_BinaryPath));
+    BP_CHECK(document.Decode().dump() == root.dump());
+    BP_CHECK(document.NodeCount() == 2);
+    if (document.NodeCount() == 2)
+    {
+        BP_CHECK(document.Decode(document.Node(1).m_Value).dump() == imgui_json::value(node).dump());
+        BP_CHECK(document.String(document.Node(0).m_Name) == "Entry");
+    }
+    BP_CHECK(document.Member(document.Root(), "text") != BP_BINARY_NONE);
+    BP_CHECK(document.Member(document.Root(), "missing") == BP_BINARY_NONE);
+    document.Close();
+
+    auto loaded = BinaryDocument::Load(s_BinaryPath);
+    BP_CHECK(loaded.second && loaded.first.dump() == root.dump());
+    remove(s_BinaryPath);
+}
+
+// a saved blueprint goes json -> binary -> BP -> json unchanged, and still runs
+static void BlueprintRoundTrip()
+{
+    HeadlessEditor editor;
+    BP blueprint;
+    auto entry = AddNode<SystemEntryPointNode>(blueprint);
+    auto parallel = AddNode<ParallelNode>(blueprint);
+    auto loop = AddNode<LoopNode>(blueprint);
+    auto join = AddNode<JoinNode>(blueprint);
+    auto exit = AddNode<SystemExitPointNode>(blueprint);
+    BP_CHECK(entry->m_Exit.LinkTo(parallel->m_Enter));
+    BP_CHECK(parallel->m_BranchA.LinkTo(loop->m_Enter));
+    BP_CHECK(loop->m_Completed.LinkTo(join->m_Enter));
+    BP_CHECK(join->m_Exit.LinkTo(exit->m_Enter));
+    loop->m_FirstIndex.m_Value = 5;
+    loop->m_LastIndex.m_Value = 7;
+
+    imgui_json::value saved;
+    blueprint.Save(saved);
+    BP_CHECK(BinaryDocument::Save(saved, s_BinaryPath));
+
+    BP loaded;
+    BP_CHECK(loaded.Load(std::string(s_BinaryPath)) == BP_ERR_NONE);
+    imgui_json::value resaved;
+    loaded.Save(resaved);
+    BP_CHECK(resaved.dump() == saved.dump());
+
+    auto loadedLoop = dynamic_cast<LoopNode*>(loaded.FindNode(loop->m_ID));
+    BP_CHECK(loadedLoop && loadedLoop->m_FirstIndex.m_Value == 5 && loadedLoop->m_LastIndex.m_Value == 7);
+    auto loadedEntry = loaded.FindNode(entry->m_ID);
+    BP_CHECK(loadedEntry && loaded.Run(*loadedEntry) == StepResult::Done);
+    remove(s_BinaryPath);
+}
+
+// a binary document keeps the blueprint json it was saved with as its state
+static void DocumentRoundTrip()
+{
+    HeadlessEditor editor;
+    imgui_json::value saved;
+    {
+        BP blueprint;
+        auto entry = AddNode<SystemEntryPointNode>(blueprint);
+        auto exit = AddNode<SystemExitPointNode>(blueprint);
+        BP_CHECK(entry->m_Exit.LinkTo(exit->m_Enter));
+        blueprint.Save(saved);
+    }
+    imgui_json::value root;
+    root["document"]["nodes"] = imgui_json::object{};
+    root["document"]["selection"] = imgui_json::array{};
+    root["document"]["blueprint"] = saved;
+    root["view"] = imgui_json::object{};
+    BP_CHECK(BinaryDocument::Save(root, s_BinaryPath));
+
+    Document document;
+    BP_CHECK(document.Load(s_BinaryPath) == BP_ERR_NONE);
+    BP_CHECK(document.m_DocumentState.m_BlueprintState.dump() == saved.dump());
+    BP_CHECK(document.m_Blueprint.GetNodes().size() == 2);
+    remove(s_BinaryPath);
+}
+
+static void DepthLimit()
+{
+    BinaryDocument document;
+    BP_CHECK(BinaryDocument::Save(Nested(BP_BINARY_MAX_DEPTH), s_BinaryPath));
+    BP_CHECK(document.Open(s_BinaryPath));
+    BP_CHECK(document.Decode().dump() == Nested(BP_BINARY_MAX_DEPTH).dump());
+    document.Close();
+
+    BP_CHECK(BinaryDocument::Save(Nested(BP_BINARY_MAX_DEPTH + 1), s_BinaryPath));
+    BP_CHECK(!document.Open(s_BinaryPath));
+    remove(s_BinaryPath);
+}
+
+// a cut off file is refused instead of read past its end
+static void TruncatedFile()
+{
+    BP_CHECK(BinaryDocument::Save(Nested(4), s_BinaryPath));
+    std::vector<char> data(4096);
+    auto file = fopen(s_BinaryPath, "rb");
+    BP_CHECK(file != nullptr);
+    if (!file)
+        return;
+    auto size = fread(data.data(), 1, data.size(), file);
+    fclose(file);
+
+    file = fopen(s_BinaryPath, "wb");
+    fwrite(data.data(), 1, size - 8, file);
+    fclose(file);
+    BinaryDocument document;
+    BP_CHECK(!document.Open(s_BinaryPath));
+    remove(s_BinaryPath);
+}
+
+int main()
+{
+    BP_RUN_TEST(JsonRoundTrip);
+    BP_RUN_TEST(BlueprintRoundTrip);
+    BP_RUN_TEST(DocumentRoundTrip);
+    BP_RUN_TEST(DepthLimit);
+    BP_RUN_TEST(TruncatedFile);
+    return BP_TEST_RESULT();
+}
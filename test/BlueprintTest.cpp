@@ -0,0 +1,80 @@
+#include "TestBlueprint.h"
+#include "UnitTest.h"
+
+using namespace BluePrint;
+
+// deleting a node keeps the others in their order and still findable by id
+static void DeleteKeepsNodeOrder()
+{
+    HeadlessEditor editor;
+    BP blueprint;
+    std::vector<ProbeNode*> probes;
+    for (int i = 0; i < 5; i++)
+        probes.push_back(AddNode<ProbeNode>(blueprint));
+
+    blueprint.DeleteNode(probes[1]);
+    probes.erase(probes.begin() + 1);
+    blueprint.DeleteNode(probes.front());
+    probes.erase(probes.begin());
+
+    auto nodes = blueprint.GetNodes();
+    BP_CHECK(nodes.size() == probes.size());
+    for (size_t i = 0; i < probes.size() && i < nodes.size(); i++)
+    {
+        BP_CHECK(nodes[i] == probes[i]);
+        BP_CHECK(blueprint.FindNode(probes[i]->m_ID) == probes[i]);
+    }
+}
+
+// a node deleted after a run leaves no state behind in the context
+static void DeleteAfterRun()
+{
+    HeadlessEditor editor;
+    BP blueprint;
+    auto entry = AddNode<SystemEntryPointNode>(blueprint);
+    auto probe = AddNode<ProbeNode>(blueprint);
+    BP_CHECK(entry->m_Exit.LinkTo(probe->m_Enter));
+    BP_CHECK(blueprint.Run(*entry) == StepResult::Done);
+    BP_CHECK(probe->Seen().size() == 1);
+
+    blueprint.DeleteNode(probe);
+    BP_CHECK(blueprint.Run(*entry) == StepResult::Done);
+}
+
+// Loop -> Count -> FloatCount, each runs its body once per iteration and then goes on
+static void InlineLoopsRunEveryIteration()
+{
+    HeadlessEditor editor;
+    BP blueprint;
+    auto entry = AddNode<SystemEntryPointNode>(blueprint);
+    auto loop = AddNode<LoopNode>(blueprint);
+    auto count = AddNode<CountNode>(blueprint);
+    auto floatCount = AddNode<FloatCountNode>(blueprint);
+    auto loopBody = AddNode<ProbeNode>(blueprint);
+    auto countBody = AddNode<ProbeNode>(blueprint);
+    auto floatCountBody = AddNode<ProbeNode>(blueprint);
+    BP_CHECK(entry->m_Exit.LinkTo(loop->m_Enter));
+    BP_CHECK(loop->m_LoopBody.LinkTo(loopBody->m_Enter) && loopBody->m_Value.LinkTo(loop->m_Index));
+    BP_CHECK(loop->m_Completed.LinkTo(count->m_Enter));
+    BP_CHECK(count->m_Exit.LinkTo(countBody->m_Enter) && countBody->m_Value.LinkTo(count->m_Counter));
+    BP_CHECK(count->m_Completed.LinkTo(floatCount->m_Enter));
+    BP_CHECK(floatCount->m_Exit.LinkTo(floatCountBody->m_Enter));
+    loop->m_FirstIndex.m_Value = 1;
+    loop->m_LastIndex.m_Value = 4;
+    count->m_N.m_Value = 3;
+    floatCount->m_N.m_Value = 1.f;
+    floatCount->m_Step.m_Value = 0.25f;
+
+    BP_CHECK(blueprint.Run(*entry) == StepResult::Done);
+    BP_CHECK(loopBody->Seen() == std::vector<int32_t>({ 1, 2, 3, 4 }));
+    BP_CHECK(countBody->Seen() == std::vector<int32_t>({ 1, 2, 3 }));
+    BP_CHECK(floatCountBody->Seen().size() == 4);
+}
+
+int main()
+{
+    BP_RUN_TEST(DeleteKeepsNodeOrder);
+    BP_RUN_TEST(DeleteAfterRun);
+    BP_RUN_TEST(InlineLoopsRunEveryIteration);
+    return BP_TEST_RESULT();
+}
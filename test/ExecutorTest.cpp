@@ -0,0 +1,75 @@
+#include <Executor.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include "UnitTest.h"
+
+using namespace BluePrint;
+using Clock = std::chrono::steady_clock;
+
+static void SubmitRunsEveryTask()
+{
+    Executor executor(4);
+    std::atomic<int> count {0};
+    std::vector<std::shared_future<void>> tasks;
+    for (int i = 0; i < 1000; i++)
+        tasks.push_back(executor.Submit([&count]() { count++; }));
+    for (auto& task : tasks)
+        task.wait();
+    BP_CHECK(count == 1000);
+}
+
+// a single worker waiting on nested tasks it submitted has to run them itself
+static void NestedWaitDoesNotDeadlock()
+{
+    Executor executor(1);
+    std::atomic<int> count {0};
+    auto outer = executor.Submit([&executor, &count]()
+    {
+        std::vector<std::shared_future<void>> inner;
+        for (int i = 0; i < 8; i++)
+            inner.push_back(executor.Submit([&count]() { count++; }, true));
+        for (auto& task : inner)
+            executor.Wait(task);
+    });
+    BP_CHECK(outer.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    BP_CHECK(count == 8);
+}
+
+static void SubmitAtRunsInDeadlineOrder()
+{
+    Executor executor(1);
+    std::mutex mutex;
+    std::vector<int> order;
+    auto start = Clock::now();
+    Clock::time_point firstRun {};
+    auto late = executor.SubmitAt(start + std::chrono::milliseconds(60), [&]() { std::lock_guard<std::mutex> lock(mutex); order.push_back(2); });
+    auto early = executor.SubmitAt(start + std::chrono::milliseconds(20), [&]() { std::lock_guard<std::mutex> lock(mutex); order.push_back(1); firstRun = Clock::now(); });
+    late.wait();
+    early.wait();
+    BP_CHECK(order.size() == 2 && order[0] == 1 && order[1] == 2);
+    BP_CHECK(firstRun - start >= std::chrono::milliseconds(20));
+}
+
+static void WorkerCountFollowsSetting()
+{
+    Executor executor(3);
+    BP_CHECK(executor.GetWorkerCount() == 3);
+    executor.SetWorkerCount(1);
+    BP_CHECK(executor.GetWorkerCount() == 1);
+    // the remaining worker still takes tasks
+    auto task = executor.Submit([]() {});
+    BP_CHECK(task.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    executor.SetWorkerCount(4);
+    BP_CHECK(executor.GetWorkerCount() == 4);
+}
+
+int main()
+{
+    BP_RUN_TEST(SubmitRunsEveryTask);
+    BP_RUN_TEST(NestedWaitDoesNotDeadlock);
+    BP_RUN_TEST(SubmitAtRunsInDeadlineOrder);
+    BP_RUN_TEST(WorkerCountFollowsSetting);
+    return BP_TEST_RESULT();
+}
@@ -0,0 +1,84 @@
+#include "TestBlueprint.h"
+#include "UnitTest.h"
+
+using namespace BluePrint;
+
+// bridge pins report their side as soon as they are added
+static void AddedBridgePinsHaveSide()
+{
+    HeadlessEditor editor;
+    BP blueprint;
+    auto group = AddNode<GroupNode>(blueprint);
+    auto probe = AddNode<ProbeNode>(blueprint);
+
+    Pin* bridgeIn = nullptr;
+    Pin* shadowIn = nullptr;
+    BP_CHECK(!group->AddInputPin(&probe->m_Value, &bridgeIn, &shadowIn));
+    BP_CHECK(bridgeIn && bridgeIn->IsInput() && !bridgeIn->IsOutput());
+    BP_CHECK(bridgeIn && bridgeIn->IsReceiver());
+
+    Pin* bridgeOut = nullptr;
+    Pin* shadowOut = nullptr;
+    BP_CHECK(!group->AddOutputPin(&probe->m_Out, &bridgeOut, &shadowOut));
+    BP_CHECK(bridgeOut && bridgeOut->IsOutput() && !bridgeOut->IsInput());
+    BP_CHECK(bridgeOut && bridgeOut->IsProvider());
+
+    // adding the same pin again hands back the existing bridge
+    Pin* again = nullptr;
+    BP_CHECK(group->AddInputPin(&probe->m_Value, &again, &shadowIn));
+    BP_CHECK(again == bridgeIn);
+}
+
+// the pins left after a removal keep their side
+static void RemovedBridgePinLeavesOthers()
+{
+    HeadlessEditor editor;
+    BP blueprint;
+    auto group = AddNode<GroupNode>(blueprint);
+    auto probe = AddNode<ProbeNode>(blueprint);
+
+    Pin* bridgeFlow = nullptr;
+    Pin* bridgeValue = nullptr;
+    Pin* shadow = nullptr;
+    group->AddInputPin(&probe->m_Enter, &bridgeFlow, &shadow);
+    group->AddInputPin(&probe->m_Value, &bridgeValue, &shadow);
+    BP_CHECK(group->GetInputPins().size() == 2);
+
+    group->RemoveInputPin(&probe->m_Value, false);
+    BP_CHECK(group->GetInputPins().size() == 1);
+    BP_CHECK(bridgeFlow->IsInput() && !bridgeFlow->IsOutput());
+}
+
+// a loaded group creates its bridge pins anew, they know their side without a compile
+static void LoadedBridgePinsHaveSide()
+{
+    HeadlessEditor editor;
+    imgui_json::value saved;
+    {
+        BP blueprint;
+        auto group = AddNode<GroupNode>(blueprint);
+        auto probe = AddNode<ProbeNode>(blueprint);
+        Pin* bridge = nullptr;
+        Pin* shadow = nullptr;
+        group->AddInputPin(&probe->m_Value, &bridge, &shadow);
+        group->AddOutputPin(&probe->m_Out, &bridge, &shadow);
+        group->Save(saved);
+    }
+
+    BP blueprint;
+    auto group = AddNode<GroupNode>(blueprint);
+    BP_CHECK(group->Load(saved) == BP_ERR_NONE);
+    BP_CHECK(group->GetInputPins().size() == 1 && group->GetOutputPins().size() == 1);
+    for (auto pin : group->GetInputPins())
+        BP_CHECK(pin->IsInput() && pin->IsReceiver());
+    for (auto pin : group->GetOutputPins())
+        BP_CHECK(pin->IsOutput() && pin->IsProvider());
+}
+
+int main()
+{
+    BP_RUN_TEST(AddedBridgePinsHaveSide);
+    BP_RUN_TEST(RemovedBridgePinLeavesOthers);
+    BP_RUN_TEST(LoadedBridgePinsHaveSide);
+    return BP_TEST_RESULT();
+}
@@ -0,0 +1,161 @@
+#include "TestBlueprint.h"
+#include "UnitTest.h"
+
+using namespace BluePrint;
+
+namespace BluePrint
+{
+// Data only node with a value Collect has no json form for
+struct MatSourceNode final : Node
+{
+    BP_NODE(MatSourceNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Default, "Test", NODE_FLAG_THREAD_SAFE | NODE_FLAG_DETERMINISTIC)
+
+    MatSourceNode(BP* blueprint): Node(blueprint) { m_Name = "Mat Source"; }
+
+    span<Pin*> GetOutputPins() override { return m_OutputPins; }
+
+    MatPin m_Mat = { this, "Mat" };
+
+    Pin* m_OutputPins[1] = { &m_Mat };
+};
+} // namespace BluePrint
+
+// Start -> ParallelFor { Probe(Index) } -> Done probe, the body probe output is reduced
+struct ParallelForGraph
+{
+    ParallelForGraph(int32_t from, int32_t to, int32_t step, int reduceType)
+    {
+        m_Entry = AddNode<SystemEntryPointNode>(m_Blueprint);
+        m_For   = AddNode<ParallelForNode>(m_Blueprint);
+        m_Body  = AddNode<ProbeNode>(m_Blueprint);
+        m_Done  = AddNode<ProbeNode>(m_Blueprint);
+
+        m_Linked = m_Entry->m_Exit.LinkTo(m_For->m_Enter)
+                && m_For->m_LoopBody.LinkTo(m_Body->m_Enter)
+                && m_Body->m_Value.LinkTo(m_For->m_Index)
+                && m_For->m_Value.LinkTo(m_Body->m_Out)
+                && m_For->m_Completed.LinkTo(m_Done->m_Enter);
+
+        m_For->m_FirstIndex.m_Value = from;
+        m_For->m_LastIndex.m_Value = to;
+        m_For->m_Step.m_Value = step;
+        m_For->m_reduce_type = reduceType;
+    }
+
+    double Result() const
+    {
+        auto value = m_Blueprint.GetContext().PeekPinValue(m_For->m_Result);
+        return value ? value->As<double>() : -1.0;
+    }
+
+    HeadlessEditor          m_Editor;
+    BP                      m_Blueprint;
+    bool                    m_Linked {false};
+    SystemEntryPointNode*   m_Entry {nullptr};
+    ParallelForNode*        m_For {nullptr};
+    ProbeNode*              m_Body {nullptr};
+    ProbeNode*              m_Done {nullptr};
+};
+
+static void SumMinMax()
+{
+    ParallelForGraph sum(0, 9, 1, ParallelForNode::REDUCE_TYPE_SUM);
+    BP_CHECK(sum.m_Linked);
+    BP_CHECK(sum.m_Blueprint.Run(*sum.m_Entry) == StepResult::Done);
+    BP_CHECK(sum.Result() == 45.0);
+    BP_CHECK(sum.m_Body->Seen().size() == 10);
+    BP_CHECK(sum.m_Done->Seen().size() == 1);
+
+    ParallelForGraph min(0, 9, 1, ParallelForNode::REDUCE_TYPE_MIN);
+    BP_CHECK(min.m_Blueprint.Run(*min.m_Entry) == StepResult::Done);
+    BP_CHECK(min.Result() == 0.0);
+
+    ParallelForGraph max(0, 9, 1, ParallelForNode::REDUCE_TYPE_MAX);
+    BP_CHECK(max.m_Blueprint.Run(*max.m_Entry) == StepResult::Done);
+    BP_CHECK(max.Result() == 9.0);
+}
+
+// enough iterations to be split in chunks, the sum stays the same
+static void LargeRangeSum()
+{
+    ParallelForGraph graph(0, 999, 1, ParallelForNode::REDUCE_TYPE_SUM);
+    BP_CHECK(graph.m_Blueprint.Run(*graph.m_Entry) == StepResult::Done);
+    BP_CHECK(graph.Result() == 499500.0);
+    BP_CHECK(graph.m_Body->Seen().size() == 1000);
+}
+
+// collected items keep index order whatever the chunks finish
+static void CollectKeepsIndexOrder()
+{
+    ParallelForGraph graph(0, 9, 1, ParallelForNode::REDUCE_TYPE_COLLECT);
+    BP_CHECK(graph.m_Blueprint.Run(*graph.m_Entry) == StepResult::Done);
+    auto value = graph.m_Blueprint.GetContext().PeekPinValue(graph.m_For->m_Items);
+    BP_CHECK(value != nullptr);
+    if (!value)
+        return;
+    auto& items = value->As<imgui_json::array>();
+    BP_CHECK(items.size() == 10);
+    for (size_t i = 0; i < items.size(); i++)
+        BP_CHECK(items[i].is_number() && items[i].get<imgui_json::number>() == double(i));
+}
+
+// results without a json form become null items, the others keep their index
+static void CollectKeepsUnconvertedSlots()
+{
+    ParallelForGraph graph(0, 3, 1, ParallelForNode::REDUCE_TYPE_COLLECT);
+    auto source = AddNode<MatSourceNode>(graph.m_Blueprint);
+    BP_CHECK(graph.m_For->m_Value.LinkTo(source->m_Mat));
+    BP_CHECK(graph.m_Blueprint.Run(*graph.m_Entry) == StepResult::Done);
+    auto value = graph.m_Blueprint.GetContext().PeekPinValue(graph.m_For->m_Items);
+    BP_CHECK(value != nullptr);
+    if (!value)
+        return;
+    auto& items = value->As<imgui_json::array>();
+    BP_CHECK(items.size() == 4);
+    for (auto& item : items)
+        BP_CHECK(item.is_null());
+}
+
+// the body runs in chunk contexts, its timing is merged into the primary context and shown on the node
+static void BodyTimingIsMerged()
+{
+    ParallelForGraph graph(0, 9, 1, ParallelForNode::REDUCE_TYPE_SUM);
+    BP_CHECK(graph.m_Blueprint.Run(*graph.m_Entry) == StepResult::Done);
+    BP_CHECK(graph.m_Body->m_HitCount == 10);
+    BP_CHECK(graph.m_Body->m_AvgTimeMs >= 0.0);
+
+    // a context of its own keeps its timing to itself
+    ParallelForGraph other(0, 9, 1, ParallelForNode::REDUCE_TYPE_SUM);
+    auto context = other.m_Blueprint.CreateContext();
+    BP_CHECK(other.m_Blueprint.Run(*context, *other.m_Entry) == StepResult::Done);
+    BP_CHECK(other.m_Body->m_HitCount == 0);
+    BP_CHECK(context->GetNodeState(*other.m_Body).m_HitCount == 10);
+}
+
+static void SteppedRange()
+{
+    ParallelForGraph graph(1, 10, 3, ParallelForNode::REDUCE_TYPE_SUM);
+    BP_CHECK(graph.m_Blueprint.Run(*graph.m_Entry) == StepResult::Done);
+    BP_CHECK(graph.Result() == 1.0 + 4.0 + 7.0 + 10.0);
+}
+
+// a step that never reaches To stops the flow instead of hanging
+static void NonPositiveStepStops()
+{
+    ParallelForGraph graph(0, 9, 0, ParallelForNode::REDUCE_TYPE_SUM);
+    graph.m_Blueprint.Run(*graph.m_Entry);
+    BP_CHECK(graph.m_Body->Seen().empty());
+    BP_CHECK(graph.m_Done->Seen().empty());
+}
+
+int main()
+{
+    BP_RUN_TEST(SumMinMax);
+    BP_RUN_TEST(LargeRangeSum);
+    BP_RUN_TEST(CollectKeepsIndexOrder);
+    BP_RUN_TEST(CollectKeepsUnconvertedSlots);
+    BP_RUN_TEST(BodyTimingIsMerged);
+    BP_RUN_TEST(SteppedRange);
+    BP_RUN_TEST(NonPositiveStepStops);
+    return BP_TEST_RESULT();
+}
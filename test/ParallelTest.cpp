@@ -0,0 +1,92 @@
+#include "TestBlueprint.h"
+#include "UnitTest.h"
+
+using namespace BluePrint;
+
+// Start -> Parallel, A: Probe -> Join, B: Loop(5..7) { Probe } -> Join, Join -> Exit
+struct ForkGraph
+{
+    ForkGraph()
+    {
+        m_Entry     = AddNode<SystemEntryPointNode>(m_Blueprint);
+        m_Parallel  = AddNode<ParallelNode>(m_Blueprint);
+        m_ProbeA    = AddNode<ProbeNode>(m_Blueprint);
+        m_Loop      = AddNode<LoopNode>(m_Blueprint);
+        m_ProbeB    = AddNode<ProbeNode>(m_Blueprint);
+        m_Join      = AddNode<JoinNode>(m_Blueprint);
+        m_Exit      = AddNode<SystemExitPointNode>(m_Blueprint);
+
+        m_Linked = m_Entry->m_Exit.LinkTo(m_Parallel->m_Enter)
+                && m_Parallel->m_BranchA.LinkTo(m_ProbeA->m_Enter)
+                && m_ProbeA->m_Exit.LinkTo(m_Join->m_Enter)
+                && m_Parallel->m_BranchB.LinkTo(m_Loop->m_Enter)
+                && m_Loop->m_LoopBody.LinkTo(m_ProbeB->m_Enter)
+                && m_ProbeB->m_Value.LinkTo(m_Loop->m_Index)
+                && m_Loop->m_Completed.LinkTo(m_Join->m_Enter)
+                && m_Join->m_Exit.LinkTo(m_Exit->m_Enter);
+
+        m_ProbeA->m_Value.m_Value = 1;
+        m_Loop->m_FirstIndex.m_Value = 5;
+        m_Loop->m_LastIndex.m_Value = 7;
+    }
+
+    HeadlessEditor          m_Editor;
+    BP                      m_Blueprint;
+    bool                    m_Linked {false};
+    SystemEntryPointNode*   m_Entry {nullptr};
+    ParallelNode*           m_Parallel {nullptr};
+    ProbeNode*              m_ProbeA {nullptr};
+    LoopNode*               m_Loop {nullptr};
+    ProbeNode*              m_ProbeB {nullptr};
+    JoinNode*               m_Join {nullptr};
+    SystemExitPointNode*    m_Exit {nullptr};
+};
+
+// the branch context resets the loop, it starts at From and not at the default 0
+static void LoopInBranchStartsAtFirstIndex()
+{
+    ForkGraph graph;
+    BP_CHECK(graph.m_Linked);
+    BP_CHECK(graph.m_Blueprint.Run(*graph.m_Entry) == StepResult::Done);
+    BP_CHECK(graph.m_ProbeA->Seen() == std::vector<int32_t>({ 1 }));
+    BP_CHECK(graph.m_ProbeB->Seen() == std::vector<int32_t>({ 5, 6, 7 }));
+
+    // a second run starts over from From as well
+    BP_CHECK(graph.m_Blueprint.Run(*graph.m_Entry) == StepResult::Done);
+    BP_CHECK(graph.m_ProbeB->Seen() == std::vector<int32_t>({ 5, 6, 7, 5, 6, 7 }));
+}
+
+static void BranchValuesAreMerged()
+{
+    ForkGraph graph;
+    BP_CHECK(graph.m_Linked);
+    BP_CHECK(graph.m_Blueprint.Run(*graph.m_Entry) == StepResult::Done);
+
+    auto& context = graph.m_Blueprint.GetContext();
+    auto valueA = context.PeekPinValue(graph.m_ProbeA->m_Out);
+    auto valueB = context.PeekPinValue(graph.m_ProbeB->m_Out);
+    BP_CHECK(valueA && valueA->As<int32_t>() == 1);
+    BP_CHECK(valueB && valueB->As<int32_t>() == 7);
+}
+
+static void UnlinkedBranchesComplete()
+{
+    HeadlessEditor editor;
+    BP blueprint;
+    auto entry = AddNode<SystemEntryPointNode>(blueprint);
+    auto parallel = AddNode<ParallelNode>(blueprint);
+    auto probe = AddNode<ProbeNode>(blueprint);
+    BP_CHECK(entry->m_Exit.LinkTo(parallel->m_Enter));
+    BP_CHECK(parallel->m_Completed.LinkTo(probe->m_Enter));
+    probe->m_Value.m_Value = 3;
+    BP_CHECK(blueprint.Run(*entry) == StepResult::Done);
+    BP_CHECK(probe->Seen() == std::vector<int32_t>({ 3 }));
+}
+
+int main()
+{
+    BP_RUN_TEST(LoopInBranchStartsAtFirstIndex);
+    BP_RUN_TEST(BranchValuesAreMerged);
+    BP_RUN_TEST(UnlinkedBranchesComplete);
+    return BP_TEST_RESULT();
+}
@@ -0,0 +1,151 @@
+#include "TestBlueprint.h"
+#include "UnitTest.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace BluePrint;
+using Clock = std::chrono::steady_clock;
+
+namespace BluePrint
+{
+// Suspends until Context::Resume on the first entry, goes on from m_Exit after that
+struct WaitNode final : Node
+{
+    BP_NODE(WaitNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Default, "Test", NODE_FLAG_THREAD_SAFE)
+
+    struct WaitState : NodeState
+    {
+        bool m_Waiting {false};
+    };
+
+    WaitNode(BP* blueprint): Node(blueprint) { m_Name = "Wait"; }
+
+    NodeState* CreateState() const override { return new WaitState(); }
+
+    FlowPin Execute(Context& context, FlowPin& entryPoint, bool threading = false) override
+    {
+        auto& state = context.GetNodeState<WaitState>(*this);
+        if (state.m_Waiting)
+        {
+            state.m_Waiting = false;
+            return m_Exit;
+        }
+        state.m_Waiting = true;
+        context.Suspend();
+        context.PushReturnPoint(entryPoint);
+        m_Suspended = true;
+        return {};
+    }
+
+    span<Pin*> GetInputPins() override { return m_InputPins; }
+    span<Pin*> GetOutputPins() override { return m_OutputPins; }
+
+    FlowPin m_Enter = { this, "Enter" };
+    FlowPin m_Exit  = { this, "Exit" };
+
+    Pin* m_InputPins[1] = { &m_Enter };
+    Pin* m_OutputPins[1] = { &m_Exit };
+
+    std::atomic<bool> m_Suspended {false};
+};
+} // namespace BluePrint
+
+// Start -> Timer(20ms, 2 events), Event -> probe, Exit -> probe
+struct TimerGraph
+{
+    TimerGraph()
+    {
+        m_Entry = AddNode<SystemEntryPointNode>(m_Blueprint);
+        m_Timer = AddNode<TimerNode>(m_Blueprint);
+        m_Event = AddNode<ProbeNode>(m_Blueprint);
+        m_Done  = AddNode<ProbeNode>(m_Blueprint);
+
+        m_Linked = m_Entry->m_Exit.LinkTo(m_Timer->m_Enter)
+                && m_Timer->m_TimeOut.LinkTo(m_Event->m_Enter)
+                && m_Timer->m_Exit.LinkTo(m_Done->m_Enter);
+
+        m_Timer->m_interval_ms = 20;
+        m_Timer->m_count = 2;
+    }
+
+    HeadlessEditor          m_Editor;
+    BP                      m_Blueprint;
+    bool                    m_Linked {false};
+    SystemEntryPointNode*   m_Entry {nullptr};
+    TimerNode*              m_Timer {nullptr};
+    ProbeNode*              m_Event {nullptr};
+    ProbeNode*              m_Done {nullptr};
+};
+
+// the blocking run sleeps through the suspensions, two events and the exit are 60ms apart from the start
+static void BlockingRunWaitsForTimer()
+{
+    TimerGraph graph;
+    BP_CHECK(graph.m_Linked);
+    auto start = Clock::now();
+    BP_CHECK(graph.m_Blueprint.Run(*graph.m_Entry) == StepResult::Done);
+    BP_CHECK(Clock::now() - start >= std::chrono::milliseconds(60));
+    BP_CHECK(graph.m_Event->Seen().size() == 2);
+    BP_CHECK(graph.m_Done->Seen().size() == 1);
+}
+
+// a suspended threaded run gives its worker back, with one worker another task runs in between
+static void SuspendedRunFreesWorker()
+{
+    TimerGraph graph;
+    graph.m_Timer->m_interval_ms = 50;
+    Executor executor(1);
+    auto context = graph.m_Blueprint.CreateContext();
+    context->m_Executor = &executor;
+    graph.m_Blueprint.Execute(*context, *graph.m_Entry);
+
+    // queued behind the run, the one worker only gets to it once the run gave the worker back.
+    // The timer suspends right away, so that is long before the 150ms are over
+    std::atomic<bool> runEnded {true};
+    auto task = executor.Submit([&]()
+    {
+        runEnded = context->m_Task.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    });
+    BP_CHECK(task.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    BP_CHECK(!runEnded);
+    BP_CHECK(context->m_Task.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    BP_CHECK(graph.m_Event->Seen().size() == 2);
+    BP_CHECK(graph.m_Done->Seen().size() == 1);
+}
+
+// a run suspended without timeout goes on only after Resume, called from another thread
+static void ResumeContinuesRun()
+{
+    HeadlessEditor editor;
+    BP blueprint;
+    auto entry = AddNode<SystemEntryPointNode>(blueprint);
+    auto wait = AddNode<WaitNode>(blueprint);
+    auto done = AddNode<ProbeNode>(blueprint);
+    BP_CHECK(entry->m_Exit.LinkTo(wait->m_Enter));
+    BP_CHECK(wait->m_Exit.LinkTo(done->m_Enter));
+
+    Executor executor(1);
+    auto context = blueprint.CreateContext();
+    context->m_Executor = &executor;
+    blueprint.Execute(*context, *entry);
+
+    auto deadline = Clock::now() + std::chrono::seconds(5);
+    while (!wait->m_Suspended && Clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    BP_CHECK(wait->m_Suspended);
+    BP_CHECK(context->m_Task.wait_for(std::chrono::milliseconds(30)) == std::future_status::timeout);
+    BP_CHECK(done->Seen().empty());
+
+    context->Resume();
+    BP_CHECK(context->m_Task.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    BP_CHECK(done->Seen().size() == 1);
+}
+
+int main()
+{
+    BP_RUN_TEST(BlockingRunWaitsForTimer);
+    BP_RUN_TEST(SuspendedRunFreesWorker);
+    BP_RUN_TEST(ResumeContinuesRun);
+    return BP_TEST_RESULT();
+}
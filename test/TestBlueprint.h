@@ -0,0 +1,81 @@
+#pragma once
+#include <imgui.h>
+#include <imgui_node_editor.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <BuildInNodes.h>
+#include <mutex>
+#include <vector>
+
+namespace BluePrint
+{
+// Pin::LinkTo reports link changes to the node editor, the tests keep one that is never drawn
+struct HeadlessEditor
+{
+    HeadlessEditor()
+    {
+        m_ImGui = ImGui::CreateContext();
+        m_Config.SettingsFile = nullptr;
+        m_Editor = ed::CreateEditor(&m_Config);
+        ed::SetCurrentEditor(m_Editor);
+    }
+    ~HeadlessEditor()
+    {
+        ed::SetCurrentEditor(nullptr);
+        ed::DestroyEditor(m_Editor);
+        ImGui::DestroyContext(m_ImGui);
+    }
+
+    ImGuiContext*       m_ImGui {nullptr};
+    ed::Config          m_Config;
+    ed::EditorContext*  m_Editor {nullptr};
+};
+
+// Records every value it is run with and passes it on to m_Out
+struct ProbeNode final : Node
+{
+    BP_NODE(ProbeNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Default, "Test", NODE_FLAG_THREAD_SAFE)
+
+    ProbeNode(BP* blueprint): Node(blueprint) { m_Name = "Probe"; }
+
+    FlowPin Execute(Context& context, FlowPin& entryPoint, bool threading = false) override
+    {
+        auto value = context.GetPinValue<int32_t>(m_Value);
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Seen.push_back(value);
+        }
+        context.SetPinValue(m_Out, value);
+        return m_Exit;
+    }
+
+    std::vector<int32_t> Seen()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Seen;
+    }
+
+    span<Pin*> GetInputPins() override { return m_InputPins; }
+    span<Pin*> GetOutputPins() override { return m_OutputPins; }
+
+    FlowPin  m_Enter = { this, "Enter" };
+    Int32Pin m_Value = { this, "Value" };
+    FlowPin  m_Exit  = { this, "Exit" };
+    Int32Pin m_Out   = { this, "Out" };
+
+    Pin* m_InputPins[2] = { &m_Enter, &m_Value };
+    Pin* m_OutputPins[2] = { &m_Exit, &m_Out };
+
+    std::mutex              m_Mutex;
+    std::vector<int32_t>    m_Seen;
+};
+
+// Nodes made here are owned by the blueprint like the ones CreateNode makes
+template <typename T>
+T* AddNode(BP& blueprint)
+{
+    auto node = new T(&blueprint);
+    blueprint.InsertNode(node);
+    return node;
+}
+} // namespace BluePrint
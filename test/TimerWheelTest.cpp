@@ -0,0 +1,118 @@
+#include <TimerWheel.h>
+#include <chrono>
+#include <vector>
+#include "UnitTest.h"
+
+using namespace BluePrint;
+using Clock = TimerWheel::Clock;
+using std::chrono::milliseconds;
+using std::chrono::hours;
+
+// turns the wheel to now and runs what expired, in the order Advance returned it
+static void Fire(TimerWheel& wheel, Clock::time_point now)
+{
+    std::vector<TimerWheel::Callback> expired;
+    wheel.Advance(now, expired);
+    for (auto& callback : expired)
+        callback();
+}
+
+static void EmptyWheel()
+{
+    TimerWheel wheel;
+    BP_CHECK(wheel.Empty());
+    BP_CHECK(wheel.Size() == 0);
+    BP_CHECK(wheel.NextExpiry() == Clock::time_point::max());
+    std::vector<TimerWheel::Callback> expired;
+    wheel.Advance(Clock::now() + milliseconds(100), expired);
+    BP_CHECK(expired.empty());
+}
+
+static void AdvanceInDeadlineOrder()
+{
+    TimerWheel wheel;
+    auto start = Clock::now();
+    std::vector<int> order;
+    wheel.Add(start + milliseconds(30), [&]() { order.push_back(30); });
+    wheel.Add(start + milliseconds(10), [&]() { order.push_back(10); });
+    wheel.Add(start + milliseconds(20), [&]() { order.push_back(20); });
+    wheel.Add(start + milliseconds(10), [&]() { order.push_back(11); });
+    BP_CHECK(wheel.Size() == 4);
+
+    // never before the deadline
+    Fire(wheel, start + milliseconds(9));
+    BP_CHECK(order.empty());
+
+    Fire(wheel, start + milliseconds(15));
+    BP_CHECK(order == std::vector<int>({ 10, 11 }));
+    BP_CHECK(wheel.Size() == 2);
+
+    Fire(wheel, start + milliseconds(40));
+    BP_CHECK(order == std::vector<int>({ 10, 11, 20, 30 }));
+    BP_CHECK(wheel.Empty());
+}
+
+// timers beyond the first level and beyond the top level come down as the wheel turns
+static void CascadeAndOverflow()
+{
+    TimerWheel wheel;
+    auto start = Clock::now();
+    std::vector<int> order;
+    wheel.Add(start + hours(5), [&]() { order.push_back(4); });                 // past 64^4 ticks, overflow
+    wheel.Add(start + milliseconds(300000), [&]() { order.push_back(3); });     // level 3
+    wheel.Add(start + milliseconds(5000), [&]() { order.push_back(2); });       // level 2
+    wheel.Add(start + milliseconds(100), [&]() { order.push_back(1); });        // level 1
+    BP_CHECK(wheel.Size() == 4);
+
+    Fire(wheel, start + milliseconds(99));
+    BP_CHECK(order.empty());
+    Fire(wheel, start + milliseconds(102));
+    BP_CHECK(order == std::vector<int>({ 1 }));
+    Fire(wheel, start + milliseconds(4999));
+    BP_CHECK(order.size() == 1);
+    Fire(wheel, start + hours(6));
+    BP_CHECK(order == std::vector<int>({ 1, 2, 3, 4 }));
+    BP_CHECK(wheel.Empty());
+}
+
+// one Advance far ahead still hands out every timer in deadline order
+static void SingleAdvanceKeepsOrder()
+{
+    TimerWheel wheel;
+    auto start = Clock::now();
+    std::vector<int> order;
+    for (int i = 9; i >= 0; i--)
+        wheel.Add(start + milliseconds(1 << (i * 2)), [&order, i]() { order.push_back(i); });
+    Fire(wheel, start + hours(1));
+    BP_CHECK(order == std::vector<int>({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+}
+
+static void NextExpiry()
+{
+    TimerWheel wheel;
+    auto start = Clock::now();
+    wheel.Add(start + milliseconds(100), []() {});
+    // a higher level gives the tick its slot cascades at, which may be earlier but never later
+    auto next = wheel.NextExpiry();
+    BP_CHECK(next <= start + milliseconds(101));
+    BP_CHECK(next != Clock::time_point::max());
+
+    // a timer already due wants an immediate wake-up
+    wheel.Add(start - milliseconds(1), []() {});
+    next = wheel.NextExpiry();
+    BP_CHECK(next <= Clock::now());
+
+    Fire(wheel, start + milliseconds(200));
+    BP_CHECK(wheel.Empty());
+    BP_CHECK(wheel.NextExpiry() == Clock::time_point::max());
+}
+
+int main()
+{
+    BP_RUN_TEST(EmptyWheel);
+    BP_RUN_TEST(AdvanceInDeadlineOrder);
+    BP_RUN_TEST(CascadeAndOverflow);
+    BP_RUN_TEST(SingleAdvanceKeepsOrder);
+    BP_RUN_TEST(NextExpiry);
+    return BP_TEST_RESULT();
+}
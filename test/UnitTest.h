@@ -0,0 +1,25 @@
+#pragma once
+#include <stdio.h>
+
+// Minimal checks for the headless tests, every test binary returns non zero when a check failed
+static int g_TestFailures = 0;
+
+# define BP_CHECK(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            g_TestFailures++; \
+        } \
+    } while (0)
+
+# define BP_RUN_TEST(test) \
+    do \
+    { \
+        auto failures = g_TestFailures; \
+        test(); \
+        fprintf(stderr, "[%s] %s\n", g_TestFailures == failures ? "  OK  " : "FAILED", #test); \
+    } while (0)
+
+# define BP_TEST_RESULT() (g_TestFailures == 0 ? 0 : 1)